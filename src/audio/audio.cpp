@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <util/log.h>
+#include <util/spsc_queue.h>
+#include "audio.h"
+
+#include <SDL2/SDL.h>
+
+namespace Audio {
+    // Samples the device asks for at a time, and how many to have left in the queue when the next frame's arrive. At
+    // 48kHz that's about 11ms and 10ms, which with a frame's worth (~17ms) on top is ~37ms of sound behind the picture
+    // while the queue is on target.
+    constexpr int device_samples = 512;
+    constexpr int target_fill = 480;
+    // How far rate_ratio() goes either way, reached once the queue is off target by a quarter
+    constexpr double max_rate_change = 0.005;
+    // The device takes samples in bursts, so the fill seen once a frame jumps around. Averaged over ~8 frames.
+    constexpr double fill_smoothing = 1.0 / 8;
+
+    // From the emulation thread to the audio callback. About 85ms at 48kHz, which only fills up when running fast.
+    Util::SpscQueue<s16, 4096> queue;
+    SDL_AudioDeviceID device = 0;
+    bool playing = false;
+    double smoothed_fill = 0;
+    // Repeated when the queue runs dry, since dropping to 0 would click
+    s16 last_sample = 0;
+
+    void callback(void*, Uint8* stream, int length) {
+        s16* out = reinterpret_cast<s16*>(stream);
+        int count = length / (int)sizeof(s16);
+        int i = 0;
+        while (i < count && queue.pop(last_sample)) {
+            out[i++] = last_sample;
+        }
+        std::fill(out + i, out + count, last_sample);
+    }
+
+    bool open(int sample_rate) {
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+            logwarn("No audio: %s", SDL_GetError());
+            return false;
+        }
+        SDL_AudioSpec wanted {};
+        wanted.freq = sample_rate;
+        wanted.format = AUDIO_S16SYS;
+        wanted.channels = 1;
+        wanted.samples = device_samples;
+        wanted.callback = callback;
+        SDL_AudioSpec obtained;
+        // No changes allowed, so SDL converts if the device can't do this itself
+        device = SDL_OpenAudioDevice(nullptr, 0, &wanted, &obtained, 0);
+        if (device == 0) {
+            logwarn("No audio: %s", SDL_GetError());
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            return false;
+        }
+        return true;
+    }
+
+    void queue_samples(const s16* samples, int count) {
+        if (device == 0) {
+            return;
+        }
+        // Measured before adding to it, where it's lowest, as that's what decides whether it runs dry
+        u32 fill = queue.size();
+        smoothed_fill += (fill - smoothed_fill) * fill_smoothing;
+        for (int i = 0; i < count && queue.push(samples[i]); i++) {
+        }
+        // Held until there's enough to play, or it would start off running dry
+        if (!playing && fill >= target_fill) {
+            smoothed_fill = fill;
+            SDL_PauseAudioDevice(device, 0);
+            playing = true;
+        }
+    }
+
+    double rate_ratio() {
+        if (!playing) {
+            return 1;
+        }
+        double error = 4 * (target_fill - smoothed_fill) / target_fill;
+        return 1 + max_rate_change * std::clamp(error, -1.0, 1.0);
+    }
+
+    void close() {
+        if (device != 0) {
+            SDL_CloseAudioDevice(device);
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            device = 0;
+            playing = false;
+        }
+    }
+}
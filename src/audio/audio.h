@@ -0,0 +1,19 @@
+#ifndef SMS_AUDIO_H
+#define SMS_AUDIO_H
+
+#include <util/types.h>
+
+namespace Audio {
+    // Opens the audio device for mono samples at `sample_rate`. Returns false, and stays silent, if there isn't one.
+    // Call on the main thread, like the rest of SDL's setup.
+    bool open(int sample_rate);
+    // On the emulation thread, once a frame. Never waits: samples that don't fit are dropped.
+    void queue_samples(const s16* samples, int count);
+    // How much faster than nominal to make samples, to keep the device's buffer near its target however far its
+    // clock is from the emulator's. Within a fraction of a percent of 1, so the change in pitch can't be heard.
+    double rate_ratio();
+    // Call on the main thread, before the window is closed
+    void close();
+}
+
+#endif //SMS_AUDIO_H
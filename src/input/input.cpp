@@ -0,0 +1,38 @@
+#include <util/spsc_queue.h>
+#include "input.h"
+
+namespace Input {
+    Util::SpscQueue<Event, 256> events;
+    u8 port_dc = 0xFF;
+
+    void send(Event event) {
+        events.push(event);
+    }
+
+    bool apply_events() {
+        Event event;
+        while (events.pop(event)) {
+            u8 bit = 1 << static_cast<u8>(event.button);
+            switch (event.type) {
+                case Event::Press:
+                    port_dc &= ~bit;
+                    break;
+                case Event::Release:
+                    port_dc |= bit;
+                    break;
+                case Event::Quit:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    u8 read_port_dc() {
+        return port_dc;
+    }
+
+    // The second controller and the reset button aren't connected
+    u8 read_port_dd() {
+        return 0xFF;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef SMS_INPUT_H
+#define SMS_INPUT_H
+
+#include <util/types.h>
+
+namespace Input {
+    // Bits of the first controller in port 0xDC, which read 0 while pressed
+    enum class Button : u8 {
+        Up = 0,
+        Down = 1,
+        Left = 2,
+        Right = 3,
+        Button1 = 4,
+        Button2 = 5,
+    };
+
+    struct Event {
+        enum Type : u8 {
+            Press,
+            Release,
+            Quit,
+        } type;
+        Button button;
+    };
+
+    // From the thread handling the window. Never waits: if the emulator is so far behind that the queue is full, the
+    // event is dropped.
+    void send(Event event);
+    // On the emulation thread, between frames, so the controllers don't change between interrupts. Returns false once
+    // asked to quit.
+    bool apply_events();
+
+    u8 read_port_dc();
+    u8 read_port_dd();
+}
+
+#endif //SMS_INPUT_H
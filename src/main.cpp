@@ -1,3 +1,7 @@
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vdp/video_sink.h>
 #include <vdp/sdl_render.h>
 #include "mem/rom.h"
 #include "mem/bus.h"
@@ -5,30 +9,147 @@
 #include "z80/z80.h"
 #include "util/log.h"
 #include "vdp/vdp.h"
+#include "scheduler/scheduler.h"
+#include "pacer/pacer.h"
+#include "input/input.h"
+#include "psg/psg.h"
+#include "audio/audio.h"
+
+// Runs until max_frames have been run, if it's not 0, or until asked to quit. Returns once they've all been drawn.
+void emulate(u64 max_frames) {
+    u64 frames = 0;
+    while (!max_frames || frames < max_frames) {
+        Bus::update_interrupt_line();
+        // A halted CPU can't do anything until it's interrupted, so it can skip straight there. So can one stuck
+        // polling the VDP status or RAM.
+        int idle = Scheduler::cpu_cycles_until(Scheduler::next_event(Scheduler::Event::VdpFrameInterrupt));
+        int budget = Bus::cpu.halted ? idle : Scheduler::cpu_cycles_until(Scheduler::next_event());
+        Scheduler::advance(budget + Bus::cpu.run(budget, idle));
+        // Emulation runs to the pacer's clock, not the display's, and drops frames it hasn't time to show
+        if (Vdp::frame_count != frames) {
+            frames = Vdp::frame_count;
+            Psg::end_frame(Scheduler::now);
+            Audio::queue_samples(Psg::samples(), Psg::sample_count());
+            Psg::set_rate_ratio(Audio::rate_ratio());
+            // The last frame of a --frames run is always shown, however fast it's running
+            Vdp::present_frame = Pacer::end_frame() || frames + 1 == max_frames;
+            if (!Input::apply_events()) {
+                break;
+            }
+        }
+    }
+
+    Vdp::finish_rendering();
+}
 
 int main(int argc, char** argv) {
-    Rom::load(argv[1]);
+    const char* rom = nullptr;
+    bool render_thread = false;
+    const char* speed = nullptr;
+    const char* render_skip = nullptr;
+    const char* audio = nullptr;
+    u64 max_frames = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--render-thread")) {
+            render_thread = true;
+        } else if (!strcmp(argv[i], "--video")) {
+            const char* name = i + 1 < argc ? argv[++i] : "";
+            Vdp::video_sink = Vdp::find_video_sink(name);
+            if (!Vdp::video_sink) {
+                logdie("Unknown video backend: '%s'. Choose from sdl, null and memory.", name);
+            }
+        } else if (!strcmp(argv[i], "--speed")) {
+            speed = i + 1 < argc ? argv[++i] : "";
+        } else if (!strcmp(argv[i], "--frames")) {
+            max_frames = i + 1 < argc ? strtoull(argv[++i], nullptr, 10) : 0;
+            if (max_frames == 0) {
+                logdie("--frames needs a number of frames to run");
+            }
+        } else if (!strcmp(argv[i], "--render-skip")) {
+            render_skip = i + 1 < argc ? argv[++i] : "";
+        } else if (!strcmp(argv[i], "--audio")) {
+            audio = i + 1 < argc ? argv[++i] : "";
+            if (strcmp(audio, "sdl") != 0 && strcmp(audio, "none") != 0) {
+                logdie("Unknown audio backend: '%s'. Choose from sdl and none.", audio);
+            }
+        } else if (!strcmp(argv[i], "--report-jitter")) {
+            Pacer::report_jitter(true);
+        } else {
+            rom = argv[i];
+        }
+    }
+    if (!rom) {
+        logdie("Usage: %s [--render-thread] [--video sdl|null|memory] [--speed <multiplier>|unlimited] "
+               "[--frames <count>] [--render-skip <n>|last] [--audio sdl|none] [--report-jitter] <rom>", argv[0]);
+    }
+    if (render_skip && !strcmp(render_skip, "last")) {
+        if (!max_frames) {
+            logdie("--render-skip last needs --frames");
+        }
+        Vdp::set_render_skip(Vdp::RenderSkip::LastFrame, max_frames);
+    } else if (render_skip) {
+        u64 n = strtoull(render_skip, nullptr, 10);
+        if (n == 0) {
+            logdie("Invalid render skip: '%s'. Give n to draw every nth frame, or last.", render_skip);
+        }
+        Vdp::set_render_skip(Vdp::RenderSkip::EveryNth, n);
+    }
+    // Without a window, there's nothing to keep in time with
+    if (!speed) {
+        speed = Vdp::video_sink == &Vdp::null_sink ? "unlimited" : "1";
+    }
+    if (!strcmp(speed, "unlimited")) {
+        Pacer::reset(Pacer::Mode::Unlimited, Pacer::NTSC_FRAME_RATE);
+    } else {
+        double multiplier = atof(speed);
+        if (multiplier <= 0) {
+            logdie("Invalid speed: '%s'. Give a multiplier, or unlimited.", speed);
+        }
+        Pacer::reset(multiplier == 1 ? Pacer::Mode::Exact : Pacer::Mode::Turbo, Pacer::NTSC_FRAME_RATE, multiplier);
+    }
+    Rom::load(rom);
 
-    Z80::reset();
+    Bus::cpu.reset();
+    Bus::cpu.set_mode(Z80::JIT_SUPPORTED ? Z80::Mode::Jit : Z80::Mode::Interpreter);
+    Scheduler::reset();
     Vdp::reset();
-    Z80::set_bus_handlers(Bus::read_byte, Bus::write_byte);
-    Z80::set_port_handlers(Bus::port_in, Bus::port_out);
+    Psg::reset();
     if (Bios::try_load()) {
         logalways("Found a bios!");
     } else {
         logalways("No bios found.");
     }
-    Z80::set_pc(0);
+    Bus::reset();
+    Bus::cpu.set_pc(0);
 
-    Vdp::render_init();
+    // Sound goes with the window unless asked for
+    if (!audio) {
+        audio = Vdp::video_sink == &Vdp::sdl_sink ? "sdl" : "none";
+    }
+    if (!strcmp(audio, "sdl")) {
+        Audio::open(Psg::sample_rate);
+    }
 
-    while (1) {
-        if (Vdp::interrupt_pending()) {
-            Z80::raise_interrupt();
-        }
-        int cycles = Z80::step();
-        Vdp::step(cycles);
+    if (render_thread) {
+        Vdp::start_render_thread();
+    } else {
+        Vdp::video_sink->init();
     }
 
+    if (Vdp::video_sink == &Vdp::sdl_sink) {
+        // SDL's window and events only work on the main thread, so the emulator gets a thread of its own
+        Vdp::open_window();
+        std::thread emulator([max_frames] {
+            emulate(max_frames);
+            Vdp::stop_presenting();
+        });
+        Vdp::present_frames();
+        emulator.join();
+        Audio::close();
+        Vdp::close_window();
+    } else {
+        emulate(max_frames);
+        Audio::close();
+    }
     return 0;
 }
@@ -1,11 +1,18 @@
 #include <util/log.h>
+#include <scheduler/scheduler.h>
 #include <vdp/vdp.h>
+#include <input/input.h>
+#include <psg/psg.h>
+#include <z80/core.h>
 #include "bus.h"
 #include "bios.h"
 #include "mem.h"
 #include "rom.h"
 
+template struct Z80::Core<Bus::Z80Bus>;
+
 namespace Bus {
+    Z80::Core<Z80Bus> cpu;
 
     bool enable_joysticks = true;
     bool enable_bios = true;
@@ -23,12 +30,73 @@ namespace Bus {
         enable_ext_port = (value >> 7) & 1;
 
         //logalways("joysticks %d bios %d ram %d card_rom %d cart_rom %d ext_port %d", enable_joysticks, enable_bios, enable_ram, enable_card_rom, enable_cart_rom, enable_ext_port);
+        update_page_tables();
+    }
+
+    u8* read_pages[NUM_PAGES];
+    u8* write_pages[NUM_PAGES];
+
+    // Backs pages where nothing is mapped
+    u8 open_bus[PAGE_SIZE];
+
+    u8* rom_page(u16 address) {
+        unsigned int offset = Rom::bank_offsets[address >> 14] + (address & 0x3FFF);
+        if (offset + PAGE_SIZE > Rom::rom.data.size()) {
+            return nullptr;
+        }
+        return &Rom::rom.data[offset];
+    }
+
+    u8* bios_page(u16 address) {
+        unsigned int offset = address & 0x1FFF;
+        if (offset + PAGE_SIZE > Bios::data.size()) {
+            return nullptr;
+        }
+        return &Bios::data[offset];
+    }
+
+    void update_page_tables() {
+        for (int page = 0; page < NUM_PAGES; page++) {
+            u16 address = page << PAGE_SHIFT;
+            switch (address) {
+                case 0x0000 ... 0xBFFF:
+                    if (enable_bios && enable_cart_rom) {
+                        read_pages[page] = nullptr; // Both are mapped, the slow path combines them
+                    } else if (enable_bios) {
+                        read_pages[page] = bios_page(address);
+                    } else if (enable_cart_rom) {
+                        read_pages[page] = rom_page(address);
+                    } else {
+                        read_pages[page] = open_bus;
+                    }
+                    write_pages[page] = nullptr;
+                    break;
+                case 0xC000 ... 0xFFFF:
+                    read_pages[page] = &Mem::ram[address & 0x1FFF];
+                    // The last page contains the mapper registers, so writes to it always take the slow path
+                    write_pages[page] = address >= (0x10000 - PAGE_SIZE) ? nullptr : &Mem::ram[address & 0x1FFF];
+                    break;
+            }
+        }
+        cpu.memory_map_changed();
+    }
+
+    void reset() {
+        enable_joysticks = true;
+        enable_bios = true;
+        enable_ram = true;
+        enable_card_rom = false;
+        enable_cart_rom = false;
+        enable_ext_port = false;
+        for (u8& b : open_bus) {
+            b = 0xFF;
+        }
+        update_page_tables();
     }
 
-    u8 read_byte(u16 address) {
+    u8 read_byte_slow(u16 address) {
         switch (address) {
             case 0x0000 ... 0xBFFF: {
-                // TODO optimize
                 u8 value = 0xFF;
                 if (enable_bios) {
                     value &= Bios::data[address & 0x1FFF];
@@ -46,7 +114,7 @@ namespace Bus {
         }
     }
 
-    void write_byte(u16 address, u8 value) {
+    void write_byte_slow(u16 address, u8 value) {
         switch (address) {
             case 0x0000 ... 0xBFFF:
                 // Ignore these writes for now, I guess
@@ -57,6 +125,7 @@ namespace Bus {
             case 0xE000 ... 0xFFFF:
                 if (address >= 0xFFFC) {
                     Rom::mapper_ctrl_write(address, value);
+                    update_page_tables();
                 }
                 // Values matching the above if statement are also written to RAM.
                 Mem::ram[address & 0x1FFF] = value;
@@ -66,15 +135,33 @@ namespace Bus {
         }
     }
 
+    // The time the CPU has run up to, in master clock cycles
+    u64 now() {
+        return Scheduler::now + (u64)cpu.cycles_run() * Scheduler::cpu_divider;
+    }
+
+    void update_interrupt_line() {
+        if (Vdp::interrupt_pending()) {
+            cpu.raise_interrupt();
+        } else {
+            cpu.clear_interrupt();
+        }
+    }
+
     void port_out(u8 port, u8 value) {
         switch (port) {
-            case 0x40 ... 0x7F: // PSG ports, ignored for now
+            case 0x40 ... 0x7F:
+                Psg::write(now(), value);
                 break;
             case 0xBE:
+                Vdp::catch_up(now());
                 Vdp::write_data(value);
                 break;
             case 0xBF:
+                Vdp::catch_up(now());
                 Vdp::write_control(value);
+                // Register writes can enable or disable interrupts
+                update_interrupt_line();
                 break;
             case 0x3E:
                 update_memory_enables(value);
@@ -88,23 +175,26 @@ namespace Bus {
         switch (port) {
             case 0x40 ... 0x7F:
                 if (port & 1) {
-                    logfatal("HCounter read (oh no)");
+                    return Vdp::get_hcounter(now());
                 } else {
+                    Vdp::catch_up(now());
                     return Vdp::vcounter;
-                    logfatal("VCounter read");
                 }
-                logfatal("Read from either VCounter or HCounter!");
             case 0x80 ... 0xBF:
+                Vdp::catch_up(now());
                 if (port & 1) { // Odd port - VDP status
-                    return Vdp::get_status();
+                    u8 status = Vdp::get_status();
+                    // Reading the status acknowledges the interrupt
+                    update_interrupt_line();
+                    return status;
                 } else { // Even port - VDP data port
                     return Vdp::read_buffer;
                     logfatal("Unsupported port: 0x%02X (VDP data port)", port);
                 }
             case 0xDC: // controller data A
-                return 0xFF;
+                return Input::read_port_dc();
             case 0xDD: // controller data B / misc
-                return 0xFF;
+                return Input::read_port_dd();
             default:
                 logfatal("Unsupported port: 0x%02X", port);
         }
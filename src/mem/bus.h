@@ -2,12 +2,83 @@
 #define SMS_BUS_H
 
 #include <util/types.h>
+#include <z80/z80.h>
 
 namespace Bus {
-    u8 read_byte(u16 address);
-    void write_byte(u16 address, u8 value);
+    // The address space is split into 1KB pages. Each page maps directly to host memory, or is nullptr if accesses
+    // need to go through the slow path (mapper registers, overlapping BIOS and cartridge, etc)
+    constexpr int PAGE_SHIFT = 10;
+    constexpr int PAGE_SIZE = 1 << PAGE_SHIFT;
+    constexpr int PAGE_MASK = PAGE_SIZE - 1;
+    constexpr int NUM_PAGES = 0x10000 >> PAGE_SHIFT;
+
+    extern u8* read_pages[NUM_PAGES];
+    extern u8* write_pages[NUM_PAGES];
+
+    void reset();
+    void update_page_tables();
+
+    u8 read_byte_slow(u16 address);
+    void write_byte_slow(u16 address, u8 value);
+
+    inline u8 read_byte(u16 address) {
+        if (u8* page = read_pages[address >> PAGE_SHIFT]) {
+            return page[address & PAGE_MASK];
+        }
+        return read_byte_slow(address);
+    }
+
+    inline void write_byte(u16 address, u8 value) {
+        if (u8* page = write_pages[address >> PAGE_SHIFT]) {
+            page[address & PAGE_MASK] = value;
+            return;
+        }
+        write_byte_slow(address, value);
+    }
+
     void port_out(u8 port, u8 value);
+    // Syncs the Z80's interrupt line with the VDP. The line can only change at the end of a scanline or when the VDP
+    // ports are accessed, so this is all that needs to be checked between instructions.
+    void update_interrupt_line();
     u8 port_in(u8 port);
+
+    // Connects the Z80 core to the functions above at compile time
+    struct Z80Bus {
+        u8 read_byte(u16 address) {
+            return Bus::read_byte(address);
+        }
+
+        void write_byte(u16 address, u8 value) {
+            Bus::write_byte(address, value);
+        }
+
+        u8 port_in(u8 port) {
+            return Bus::port_in(port);
+        }
+
+        // Only the VDP status and the controllers stay the same until the next interrupt. Reading the status clears
+        // its flags, but reading it again after that does nothing.
+        bool repeatable_port_in(u8 port) {
+            return (port >= 0x80 && port <= 0xBF && (port & 1)) || port == 0xDC || port == 0xDD;
+        }
+
+        void port_out(u8 port, u8 value) {
+            Bus::port_out(port, value);
+        }
+
+        static_assert(PAGE_SIZE == Z80::CODE_PAGE_SIZE);
+        u8* code_page(u16 address) {
+            return read_pages[address >> PAGE_SHIFT];
+        }
+
+        u8* write_page(u16 address) {
+            return write_pages[address >> PAGE_SHIFT];
+        }
+    };
+
+    extern Z80::Core<Z80Bus> cpu;
 }
 
+extern template struct Z80::Core<Bus::Z80Bus>;
+
 #endif //SMS_BUS_H
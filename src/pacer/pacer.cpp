@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <util/log.h>
+#include "pacer.h"
+
+namespace Pacer {
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    // Sleeping can overshoot by about a scheduler tick, so the last of the wait is spent spinning instead
+    constexpr auto spin_time = std::chrono::microseconds(2000);
+    // Falling further behind than this (after being stopped in a debugger, say) starts the deadlines again from now,
+    // rather than running flat out to catch up
+    constexpr auto max_lag = std::chrono::milliseconds(100);
+    constexpr int frames_per_report = 600;
+
+    Mode mode = Mode::Exact;
+    Clock::duration frame_time;
+    // Time between presented frames in Turbo and Unlimited
+    Clock::duration present_time;
+    Clock::time_point deadline;
+    Clock::time_point next_present;
+    Clock::time_point last_frame;
+
+    bool reporting = false;
+    // Frame times since the last report, in milliseconds
+    int report_frames;
+    double report_sum;
+    double report_sum_squares;
+    double report_worst;
+
+    void reset_report() {
+        report_frames = 0;
+        report_sum = 0;
+        report_sum_squares = 0;
+        report_worst = 0;
+    }
+
+    void reset(Mode new_mode, double frame_rate, double speed) {
+        mode = new_mode;
+        present_time = std::chrono::duration_cast<Clock::duration>(Seconds(1 / frame_rate));
+        switch (mode) {
+            case Mode::Exact:
+                frame_time = present_time;
+                break;
+            case Mode::Turbo:
+                frame_time = std::chrono::duration_cast<Clock::duration>(Seconds(1 / (frame_rate * speed)));
+                break;
+            case Mode::Unlimited:
+                frame_time = Clock::duration::zero();
+                break;
+        }
+        deadline = next_present = last_frame = Clock::now();
+        reset_report();
+    }
+
+    void report_jitter(bool enable) {
+        reporting = enable;
+    }
+
+    void wait_until(Clock::time_point time) {
+        if (time - Clock::now() > spin_time) {
+            std::this_thread::sleep_until(time - spin_time);
+        }
+        while (Clock::now() < time) {
+        }
+    }
+
+    void record_frame_time(Clock::duration elapsed) {
+        double ms = Seconds(elapsed).count() * 1000;
+        report_sum += ms;
+        report_sum_squares += ms * ms;
+        report_worst = std::max(report_worst, ms);
+        if (++report_frames == frames_per_report) {
+            double mean = report_sum / report_frames;
+            double jitter = std::sqrt(std::max(0.0, report_sum_squares / report_frames - mean * mean));
+            logalways("Frame time over %d frames: %.3f ms mean, %.3f ms jitter (std dev), %.3f ms worst",
+                      report_frames, mean, jitter, report_worst);
+            reset_report();
+        }
+    }
+
+    bool end_frame() {
+        Clock::time_point now = Clock::now();
+        if (mode != Mode::Unlimited) {
+            deadline += frame_time;
+            if (now - deadline > max_lag) {
+                deadline = now;
+            } else {
+                wait_until(deadline);
+                now = Clock::now();
+            }
+        }
+
+        if (reporting) {
+            record_frame_time(now - last_frame);
+        }
+        last_frame = now;
+
+        if (mode == Mode::Exact) {
+            return true;
+        }
+        if (now < next_present) {
+            return false;
+        }
+        // Half a frame early, so rounding doesn't make it skip a frame too many every so often
+        next_present = now + present_time - frame_time / 2;
+        return true;
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef SMS_PACER_H
+#define SMS_PACER_H
+
+namespace Pacer {
+    // Frames per second of the VDP's NTSC and PAL timings
+    constexpr double NTSC_FRAME_RATE = 53693175.0 / (15 * 228 * 262);
+    constexpr double PAL_FRAME_RATE = 53203424.0 / (15 * 228 * 313);
+
+    enum class Mode {
+        // At the console's own frame rate
+        Exact,
+        // A multiple of the frame rate, presenting only as many frames as at the console's frame rate
+        Turbo,
+        // As fast as the host can go, presenting the same way as Turbo
+        Unlimited,
+    };
+
+    // `speed` is the multiple of frame_rate for Turbo
+    void reset(Mode mode, double frame_rate, double speed = 1);
+    // Call as each emulated frame finishes. Waits until it's time to start the next one, and returns whether the next
+    // one should be presented.
+    bool end_frame();
+    // Logs the mean frame time and its jitter every few seconds
+    void report_jitter(bool enable);
+}
+
+#endif //SMS_PACER_H
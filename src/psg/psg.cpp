@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cmath>
+#include <util/blip_buffer.h>
+#include <scheduler/scheduler.h>
+#include "psg.h"
+
+namespace Psg {
+    // The PSG runs at the CPU's clock, and its counters count down once every 16 cycles
+    constexpr int cycles_per_tick = Scheduler::cpu_divider * 16;
+
+    constexpr int NOISE = 3;
+    // Highest output of one channel, so all four together fit in a sample
+    constexpr int max_amplitude = 8191;
+
+    struct Channel {
+        // The tone period, or for the noise channel its control register
+        u16 reg;
+        // Attenuation, 2dB a step, where 15 is off
+        u8 volume;
+        u16 counter;
+        bool output;
+        // The amplitude last sent to the blip buffer
+        int amplitude;
+    };
+
+    Channel channels[4];
+    u16 lfsr;
+    // The noise channel's counter flips this like the tones flip their output, and the shift register moves on every
+    // other reload
+    bool noise_flip_flop;
+    // The channel and register the last latch byte selected
+    int latched_channel;
+    bool latched_volume;
+
+    // Time of the next tick, and of the start of the audio frame, in master clock cycles
+    u64 tick_time;
+    u64 frame_start;
+
+    int volume_table[16];
+    Util::BlipBuffer blip(Scheduler::master_clock, sample_rate);
+    s16 sample_buffer[Util::BlipBuffer::MAX_SAMPLES];
+    int samples_in_buffer = 0;
+
+    void reset() {
+        for (int i = 0; i < 16; i++) {
+            volume_table[i] = i == 15 ? 0 : (int)std::lround(max_amplitude * std::pow(10, -0.1 * i));
+        }
+        for (Channel& channel : channels) {
+            channel = {0, 15, 0, false, 0};
+        }
+        lfsr = 0x8000;
+        noise_flip_flop = false;
+        latched_channel = 0;
+        latched_volume = false;
+        tick_time = frame_start = Scheduler::now;
+        blip.clear();
+        samples_in_buffer = 0;
+    }
+
+    // Ticks between reloads of a channel's counter
+    int reload_value(int index) {
+        const Channel& channel = channels[index];
+        if (index != NOISE) {
+            // Sega's PSG treats a period of 0 as 1
+            return std::max<int>(channel.reg, 1);
+        }
+        switch (channel.reg & 3) {
+            case 0: return 0x10;
+            case 1: return 0x20;
+            case 2: return 0x40;
+            default: return std::max<int>(channels[2].reg, 1);
+        }
+    }
+
+    void update_amplitude(Channel& channel, u64 time) {
+        int amplitude = channel.output ? volume_table[channel.volume] : 0;
+        if (amplitude != channel.amplitude) {
+            blip.add_delta(time - frame_start, amplitude - channel.amplitude);
+            channel.amplitude = amplitude;
+        }
+    }
+
+    // White noise taps bits 0 and 3 of the shift register, periodic noise just bit 0
+    void clock_noise(Channel& noise, u64 time) {
+        noise.counter = reload_value(NOISE);
+        noise_flip_flop = !noise_flip_flop;
+        if (noise_flip_flop) {
+            bool white = noise.reg & 4;
+            u16 feedback = white ? ((lfsr ^ (lfsr >> 3)) & 1) : (lfsr & 1);
+            lfsr = (lfsr >> 1) | (feedback << 15);
+            noise.output = lfsr & 1;
+            update_amplitude(noise, time);
+        }
+    }
+
+    // A tone channel that's turned off can't be heard, but its output still has to be right for when it's turned back
+    // on. It's worked out directly rather than stepped, as unused channels are often left with tiny periods.
+    bool silent(int index) {
+        return index != NOISE && channels[index].volume == 15;
+    }
+
+    void advance_silent(int index, u64 ticks) {
+        Channel& channel = channels[index];
+        if (channel.counter > ticks) {
+            channel.counter -= ticks;
+            return;
+        }
+        u64 after_reload = ticks - std::max<u16>(channel.counter, 1);
+        int period = reload_value(index);
+        u64 reloads = 1 + after_reload / period;
+        channel.counter = period - after_reload % period;
+        channel.output ^= reloads & 1;
+    }
+
+    // Runs the counters up to `time`, a reload at a time rather than a tick at a time
+    void catch_up(u64 time) {
+        if (time < tick_time) {
+            return;
+        }
+        u64 ticks = (time - tick_time) / cycles_per_tick + 1;
+        for (int i = 0; i < 4; i++) {
+            if (silent(i)) {
+                advance_silent(i, ticks);
+            }
+        }
+        while (ticks > 0) {
+            u64 step = ticks;
+            for (int i = 0; i < 4; i++) {
+                if (!silent(i)) {
+                    step = std::min<u64>(step, std::max<u16>(channels[i].counter, 1));
+                }
+            }
+            u64 step_time = tick_time + (step - 1) * cycles_per_tick;
+            for (int i = 0; i < 4; i++) {
+                Channel& channel = channels[i];
+                if (silent(i)) {
+                    continue;
+                } else if (channel.counter > step) {
+                    channel.counter -= step;
+                } else if (i == NOISE) {
+                    clock_noise(channel, step_time);
+                } else {
+                    channel.counter = reload_value(i);
+                    channel.output = !channel.output;
+                    update_amplitude(channel, step_time);
+                }
+            }
+            tick_time += step * cycles_per_tick;
+            ticks -= step;
+        }
+    }
+
+    void write(u64 time, u8 value) {
+        catch_up(time);
+        if (value & 0x80) {
+            latched_channel = (value >> 5) & 3;
+            latched_volume = value & 0x10;
+        }
+        Channel& channel = channels[latched_channel];
+        if (latched_volume) {
+            channel.volume = value & 0xF;
+            update_amplitude(channel, time);
+        } else if (latched_channel == NOISE) {
+            channel.reg = value & 7;
+            lfsr = 0x8000;
+        } else if (value & 0x80) {
+            channel.reg = (channel.reg & 0x3F0) | (value & 0xF);
+        } else {
+            channel.reg = (channel.reg & 0xF) | ((value & 0x3F) << 4);
+        }
+    }
+
+    void end_frame(u64 time) {
+        catch_up(time);
+        samples_in_buffer = blip.end_frame(time - frame_start, sample_buffer);
+        frame_start = time;
+    }
+
+    void set_rate_ratio(double ratio) {
+        blip.set_rates(Scheduler::master_clock, sample_rate * ratio);
+    }
+
+    const s16* samples() {
+        return sample_buffer;
+    }
+
+    int sample_count() {
+        return samples_in_buffer;
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef SMS_PSG_H
+#define SMS_PSG_H
+
+#include <util/types.h>
+
+namespace Psg {
+    constexpr int sample_rate = 48000;
+
+    // Resets the PSG. Call Scheduler::reset() first.
+    void reset();
+    // A write to ports 0x40-0x7F at `time`, in master clock cycles
+    void write(u64 time, u8 value);
+    // Ends the audio frame at `time`, and makes its samples available through samples() and sample_count(). Call it
+    // at least every frame.
+    void end_frame(u64 time);
+    // Makes samples `ratio` times as fast as sample_rate from the next one on, to keep in step with an audio device
+    void set_rate_ratio(double ratio);
+    // Mono samples at sample_rate, valid until the next end_frame()
+    const s16* samples();
+    int sample_count();
+}
+
+#endif //SMS_PSG_H
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include "scheduler.h"
+
+namespace Scheduler {
+    u64 now = 0;
+
+    struct Entry {
+        u64 time;
+        // Breaks ties between events due at the same time
+        u64 order;
+        Event event;
+        event_handler handler;
+    };
+
+    // A min-heap on time
+    std::vector<Entry> events;
+    u64 scheduled = 0;
+
+    bool later(const Entry& a, const Entry& b) {
+        return a.time != b.time ? a.time > b.time : a.order > b.order;
+    }
+
+    void reset() {
+        now = 0;
+        events.clear();
+        scheduled = 0;
+    }
+
+    void schedule(Event event, u64 time, event_handler handler) {
+        events.push_back({time, scheduled++, event, handler});
+        std::push_heap(events.begin(), events.end(), later);
+    }
+
+    u64 next_event() {
+        return events.empty() ? UINT64_MAX : events.front().time;
+    }
+
+    u64 next_event(Event event) {
+        u64 time = UINT64_MAX;
+        for (const Entry& entry : events) {
+            if (entry.event == event) {
+                time = std::min(time, entry.time);
+            }
+        }
+        return time;
+    }
+
+    int cpu_cycles_until(u64 time) {
+        if (time <= now) {
+            return 0;
+        }
+        return std::min<u64>((time - now + cpu_divider - 1) / cpu_divider, INT_MAX);
+    }
+
+    void advance(int cycles) {
+        now += (u64)cycles * cpu_divider;
+        while (!events.empty() && events.front().time <= now) {
+            std::pop_heap(events.begin(), events.end(), later);
+            Entry entry = events.back();
+            events.pop_back();
+            // The handler can schedule more events, including ones that are already due
+            entry.handler(entry.time);
+        }
+    }
+}
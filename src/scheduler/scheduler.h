@@ -0,0 +1,33 @@
+#ifndef SMS_SCHEDULER_H
+#define SMS_SCHEDULER_H
+
+#include <util/types.h>
+
+namespace Scheduler {
+    // Time is counted in cycles of the NTSC master clock (53.693175 MHz), which every device's clock divides evenly
+    constexpr int master_clock = 53693175;
+    constexpr int cpu_divider = 15;
+
+    enum class Event {
+        VdpFrameInterrupt,
+    };
+
+    typedef void (*event_handler)(u64 time);
+
+    // Master clock cycles since reset, up to the end of the last CPU run
+    extern u64 now;
+
+    void reset();
+    // Calls handler with `time` once the CPU has run up to it. Events due at the same time run in the order they were
+    // scheduled.
+    void schedule(Event event, u64 time, event_handler handler);
+    // Time of the next event, or the next one of a kind (UINT64_MAX if there isn't one)
+    u64 next_event();
+    u64 next_event(Event event);
+    // CPU cycles until time, rounded up
+    int cpu_cycles_until(u64 time);
+    // Moves time on by `cycles` CPU cycles and runs the events that are due
+    void advance(int cycles);
+}
+
+#endif //SMS_SCHEDULER_H
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include "blip_buffer.h"
+
+namespace Util {
+    s16 BlipBuffer::kernel[PHASES][TAPS];
+
+    BlipBuffer::BlipBuffer(u32 clock_rate, u32 sample_rate) {
+        set_rates(clock_rate, sample_rate);
+        make_kernel();
+    }
+
+    void BlipBuffer::set_rates(u32 clock_rate, double sample_rate) {
+        factor = (u64)(sample_rate / clock_rate * (1ull << POSITION_BITS));
+    }
+
+    // A windowed sinc, cut off a little under the Nyquist frequency, for each phase. Each phase sums to exactly
+    // 1 << DELTA_BITS, so a step always ends up at the right level.
+    void BlipBuffer::make_kernel() {
+        constexpr double cutoff = 0.9;
+        constexpr double half_width = TAPS / 2;
+        for (int phase = 0; phase < PHASES; phase++) {
+            double taps[TAPS];
+            double sum = 0;
+            for (int tap = 0; tap < TAPS; tap++) {
+                double x = tap - (half_width - 1) - (double)phase / PHASES;
+                double sinc = x == 0 ? 1 : std::sin(M_PI * x * cutoff) / (M_PI * x * cutoff);
+                double window = 0.42 + 0.5 * std::cos(M_PI * x / half_width) + 0.08 * std::cos(2 * M_PI * x / half_width);
+                taps[tap] = sinc * window;
+                sum += taps[tap];
+            }
+            int total = 0;
+            for (int tap = 0; tap < TAPS; tap++) {
+                kernel[phase][tap] = (s16)std::lround(taps[tap] / sum * (1 << DELTA_BITS));
+                total += kernel[phase][tap];
+            }
+            // Rounding error goes on the largest tap
+            kernel[phase][TAPS / 2 - 1 + (phase >= PHASES / 2)] += (1 << DELTA_BITS) - total;
+        }
+    }
+
+    void BlipBuffer::add_delta(u32 time, int delta) {
+        u64 position = offset + time * factor;
+        u32 index = position >> POSITION_BITS;
+        int phase = (position >> (POSITION_BITS - PHASE_BITS)) & (PHASES - 1);
+        assert(index < MAX_SAMPLES);
+        int* out = &buffer[index];
+        for (int tap = 0; tap < TAPS; tap++) {
+            out[tap] += kernel[phase][tap] * delta;
+        }
+    }
+
+    int BlipBuffer::end_frame(u32 time, s16* out) {
+        u64 position = offset + time * factor;
+        int count = position >> POSITION_BITS;
+        assert(count <= MAX_SAMPLES);
+        for (int i = 0; i < count; i++) {
+            int sample = integrator >> DELTA_BITS;
+            integrator += buffer[i];
+            out[i] = (s16)std::clamp(sample, -32768, 32767);
+            integrator -= sample << (DELTA_BITS - BASS_SHIFT);
+        }
+        // The tails of the last steps carry over
+        memmove(buffer, buffer + count, TAPS * sizeof(buffer[0]));
+        memset(buffer + TAPS, 0, count * sizeof(buffer[0]));
+        offset = position - ((u64)count << POSITION_BITS);
+        return count;
+    }
+
+    void BlipBuffer::clear() {
+        offset = 0;
+        integrator = 0;
+        memset(buffer, 0, sizeof(buffer));
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef SMS_BLIP_BUFFER_H
+#define SMS_BLIP_BUFFER_H
+
+#include "types.h"
+
+namespace Util {
+    // Band-limited step synthesis. A sound chip reports when its output changes, to the clock cycle, and each change
+    // is added as a band-limited step at its exact position between samples. Nothing is generated per clock cycle, and
+    // nothing above the output's Nyquist frequency aliases back down.
+    class BlipBuffer {
+    public:
+        // Most samples in one frame
+        static constexpr int MAX_SAMPLES = 4096;
+        // How quickly the output drifts back to 0, so the chip's DC offset doesn't end up in the samples. Each sample
+        // loses 1 / (1 << BASS_SHIFT) of itself.
+        static constexpr int BASS_SHIFT = 9;
+
+        BlipBuffer(u32 clock_rate, u32 sample_rate);
+
+        // Changes the output rate, from the next step on. Samples are generated from the clock, so this is all it takes
+        // to resample.
+        void set_rates(u32 clock_rate, double sample_rate);
+
+        // Adds a step of `delta` to the output, `time` clock cycles after the start of the frame
+        void add_delta(u32 time, int delta);
+        // Ends the frame `time` clock cycles after it started, and writes its samples to `out`, which must have room
+        // for MAX_SAMPLES. Returns how many were written. Steps too close to the end of the frame to have been fully
+        // added go into the next frame's samples.
+        int end_frame(u32 time, s16* out);
+        void clear();
+
+    private:
+        static constexpr int PHASE_BITS = 5;
+        static constexpr int PHASES = 1 << PHASE_BITS;
+        static constexpr int TAPS = 16;
+        // Fraction bits of the kernel's values, and of a sample's position
+        static constexpr int DELTA_BITS = 15;
+        static constexpr int POSITION_BITS = 32;
+
+        // The difference between each sample of a step starting at each phase
+        static s16 kernel[PHASES][TAPS];
+        static void make_kernel();
+
+        // Samples per clock cycle, and the position of the start of the frame, both in 32.32 fixed point
+        u64 factor;
+        u64 offset = 0;
+        int integrator = 0;
+        int buffer[MAX_SAMPLES + TAPS] = {};
+    };
+}
+
+#endif //SMS_BLIP_BUFFER_H
@@ -0,0 +1,79 @@
+#ifndef SMS_SPSC_QUEUE_H
+#define SMS_SPSC_QUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <thread>
+
+#include "types.h"
+
+namespace Util {
+    // A fixed size queue passing values from one thread to one other thread without locks. The consumer can sleep
+    // until the producer calls notify(), so producers that batch their work only need to wake it once per batch.
+    template <typename T, u32 Size>
+    class SpscQueue {
+        static_assert(std::has_single_bit(Size));
+
+    public:
+        // Producer only. Returns false if the queue is full.
+        bool push(const T& value) {
+            u32 tail = write_index.load(std::memory_order_relaxed);
+            if (tail - read_cached == Size) {
+                read_cached = read_index.load(std::memory_order_acquire);
+                if (tail - read_cached == Size) {
+                    return false;
+                }
+            }
+            items[tail & (Size - 1)] = value;
+            write_index.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Producer only. Waits for the consumer if the queue is full.
+        void push_wait(const T& value) {
+            while (!push(value)) {
+                notify();
+                std::this_thread::yield();
+            }
+        }
+
+        // Producer only. Wakes the consumer if it's waiting.
+        void notify() {
+            write_index.notify_one();
+        }
+
+        // Consumer only. Returns false if the queue is empty.
+        bool pop(T& value) {
+            u32 head = read_index.load(std::memory_order_relaxed);
+            if (head == write_cached) {
+                write_cached = write_index.load(std::memory_order_acquire);
+                if (head == write_cached) {
+                    return false;
+                }
+            }
+            value = items[head & (Size - 1)];
+            read_index.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only. Sleeps while the queue is empty, until the producer calls notify().
+        void wait() {
+            write_index.wait(read_index.load(std::memory_order_relaxed), std::memory_order_acquire);
+        }
+
+        // Either side. The other side can change it at any moment, so it's only an estimate.
+        u32 size() const {
+            return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+        }
+
+    private:
+        // Each side's index, and its copy of the other side's, on their own cache lines
+        alignas(64) std::atomic<u32> write_index = 0;
+        u32 read_cached = 0;
+        alignas(64) std::atomic<u32> read_index = 0;
+        u32 write_cached = 0;
+        alignas(64) T items[Size];
+    };
+}
+
+#endif //SMS_SPSC_QUEUE_H
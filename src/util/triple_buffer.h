@@ -0,0 +1,51 @@
+#ifndef SMS_TRIPLE_BUFFER_H
+#define SMS_TRIPLE_BUFFER_H
+
+#include <atomic>
+
+#include "types.h"
+
+namespace Util {
+    // Hands values from one thread to one other thread without locks, and without either ever waiting. The writer fills
+    // the back buffer and publishes it, the reader picks up the most recently published one, and the third buffer in
+    // the middle is what they swap through. Anything published but not picked up in time is overwritten.
+    template <typename T>
+    class TripleBuffer {
+    public:
+        // Writer only
+        T& back() {
+            return buffers[back_index];
+        }
+
+        // Writer only. Hands the back buffer to the reader, and takes the middle one to fill next.
+        void publish() {
+            back_index = middle.exchange(back_index | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        // Reader only. Takes the latest published buffer, if there's been one since last time. Returns false if not.
+        bool update() {
+            if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+                return false;
+            }
+            front_index = middle.exchange(front_index, std::memory_order_acq_rel) & INDEX_MASK;
+            return true;
+        }
+
+        // Reader only
+        const T& front() const {
+            return buffers[front_index];
+        }
+
+    private:
+        // Set in middle when it holds a buffer the reader hasn't seen
+        static constexpr u8 FRESH = 4;
+        static constexpr u8 INDEX_MASK = 3;
+
+        T buffers[3];
+        u8 back_index = 0;
+        alignas(64) std::atomic<u8> middle = 1;
+        alignas(64) u8 front_index = 2;
+    };
+}
+
+#endif //SMS_TRIPLE_BUFFER_H
@@ -0,0 +1,152 @@
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "planar.h"
+
+namespace Vdp {
+    void planar_to_chunky_scalar(const u8* planar, u8* chunky, u8* chunky_hflip, int rows) {
+        for (int row = 0; row < rows; row++, planar += 4, chunky += 8, chunky_hflip += 8) {
+            for (int pixel = 0; pixel < 8; pixel++) {
+                int bit = 7 - pixel;
+                u8 color_index = 0;
+                for (int plane = 0; plane < 4; plane++) {
+                    color_index |= ((planar[plane] >> bit) & 1) << plane;
+                }
+                chunky[pixel] = color_index;
+                chunky_hflip[7 - pixel] = color_index;
+            }
+        }
+    }
+
+#if defined(__x86_64__)
+    // Each byte of `planes` holds a plane's byte for the row it's converting, and each byte of `bits` the bit for the
+    // pixel it ends up as. Returns that plane's bit of each pixel's colour index.
+    static inline __m128i sse2_plane_bits(__m128i planes, __m128i bits, int plane) {
+        __m128i set = _mm_cmpeq_epi8(_mm_and_si128(planes, bits), bits);
+        return _mm_and_si128(set, _mm_set1_epi8(1 << plane));
+    }
+
+    // Two rows at a time
+    void planar_to_chunky_sse2(const u8* planar, u8* chunky, u8* chunky_hflip, int rows) {
+        const __m128i bits = _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+        const __m128i bits_hflip = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+        for (int row = 0; row < rows; row += 2, planar += 8, chunky += 16, chunky_hflip += 16) {
+            __m128i bytes;
+            if (row + 1 < rows) {
+                bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(planar));
+            } else {
+                u32 last;
+                memcpy(&last, planar, sizeof(last));
+                bytes = _mm_cvtsi32_si128(last);
+            }
+
+            // Spread each plane byte over the 8 bytes of its row, the first row in the low half
+            bytes = _mm_unpacklo_epi8(bytes, bytes);
+            __m128i first = _mm_unpacklo_epi16(bytes, bytes);
+            __m128i second = _mm_unpackhi_epi16(bytes, bytes);
+            __m128i first_01 = _mm_unpacklo_epi32(first, first);
+            __m128i first_23 = _mm_unpackhi_epi32(first, first);
+            __m128i second_01 = _mm_unpacklo_epi32(second, second);
+            __m128i second_23 = _mm_unpackhi_epi32(second, second);
+            __m128i planes[] {
+                    _mm_unpacklo_epi64(first_01, second_01),
+                    _mm_unpackhi_epi64(first_01, second_01),
+                    _mm_unpacklo_epi64(first_23, second_23),
+                    _mm_unpackhi_epi64(first_23, second_23),
+            };
+
+            __m128i indices = _mm_setzero_si128();
+            __m128i indices_hflip = _mm_setzero_si128();
+            for (int plane = 0; plane < 4; plane++) {
+                indices = _mm_or_si128(indices, sse2_plane_bits(planes[plane], bits, plane));
+                indices_hflip = _mm_or_si128(indices_hflip, sse2_plane_bits(planes[plane], bits_hflip, plane));
+            }
+
+            if (row + 1 < rows) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(chunky), indices);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(chunky_hflip), indices_hflip);
+            } else {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(chunky), indices);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(chunky_hflip), indices_hflip);
+            }
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i avx2_plane_bits(__m256i planes, __m256i bits, int plane) {
+        __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(planes, bits), bits);
+        return _mm256_and_si256(set, _mm256_set1_epi8(1 << plane));
+    }
+
+    // Four rows at a time, with the SSE2 kernel finishing off the rest
+    __attribute__((target("avx2")))
+    void planar_to_chunky_avx2(const u8* planar, u8* chunky, u8* chunky_hflip, int rows) {
+        const __m256i bits = _mm256_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1,
+                                              -128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+        const __m256i bits_hflip = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                    1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        // Where each byte of a row's first plane comes from. Shuffles stay within 128 bit lanes, so the input is in
+        // both and each picks out two of the rows.
+        const __m256i first_plane = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 4, 4, 4, 4, 4, 4,
+                                                     8, 8, 8, 8, 8, 8, 8, 8, 12, 12, 12, 12, 12, 12, 12, 12);
+
+        int row = 0;
+        for (; row + 4 <= rows; row += 4, planar += 16, chunky += 32, chunky_hflip += 32) {
+            __m256i bytes = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(planar)));
+
+            __m256i indices = _mm256_setzero_si256();
+            __m256i indices_hflip = _mm256_setzero_si256();
+            for (int plane = 0; plane < 4; plane++) {
+                __m256i planes = _mm256_shuffle_epi8(bytes, _mm256_add_epi8(first_plane, _mm256_set1_epi8(plane)));
+                indices = _mm256_or_si256(indices, avx2_plane_bits(planes, bits, plane));
+                indices_hflip = _mm256_or_si256(indices_hflip, avx2_plane_bits(planes, bits_hflip, plane));
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(chunky), indices);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(chunky_hflip), indices_hflip);
+        }
+
+        if (row < rows) {
+            planar_to_chunky_sse2(planar, chunky, chunky_hflip, rows - row);
+        }
+    }
+
+    // Deposits each plane's bits into its bit of every byte. Byte n ends up with bit n of the planes, which is pixel
+    // 7 - n, so the result is already the flipped row and the unflipped one is it byte swapped.
+    __attribute__((target("bmi2")))
+    void planar_to_chunky_bmi2(const u8* planar, u8* chunky, u8* chunky_hflip, int rows) {
+        for (int row = 0; row < rows; row++, planar += 4, chunky += 8, chunky_hflip += 8) {
+            u64 indices = _pdep_u64(planar[0], 0x0101010101010101)
+                          | _pdep_u64(planar[1], 0x0202020202020202)
+                          | _pdep_u64(planar[2], 0x0404040404040404)
+                          | _pdep_u64(planar[3], 0x0808080808080808);
+            u64 indices_flipped = __builtin_bswap64(indices);
+            memcpy(chunky, &indices_flipped, sizeof(indices_flipped));
+            memcpy(chunky_hflip, &indices, sizeof(indices));
+        }
+    }
+#endif
+
+    std::vector<PlanarKernel> planar_kernels() {
+        std::vector<PlanarKernel> kernels;
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            kernels.push_back({"avx2", planar_to_chunky_avx2});
+        }
+        // PDEP is microcoded, and very slow, on AMD CPUs before Zen 3
+        if (__builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("amdfam17h")) {
+            kernels.push_back({"bmi2", planar_to_chunky_bmi2});
+        }
+        kernels.push_back({"sse2", planar_to_chunky_sse2});
+#endif
+        kernels.push_back({"scalar", planar_to_chunky_scalar});
+        return kernels;
+    }
+
+    const PlanarToChunky planar_to_chunky = planar_kernels().front().convert;
+}
@@ -0,0 +1,28 @@
+#ifndef SMS_VDP_PLANAR_H
+#define SMS_VDP_PLANAR_H
+
+#include <vector>
+
+#include <util/types.h>
+
+namespace Vdp {
+    // Converts `rows` pattern rows, stored as 4 bitplane bytes each, to a colour index per pixel. Each row becomes 8
+    // bytes in `chunky`, leftmost pixel first, and the same 8 bytes in reverse order in `chunky_hflip`.
+    using PlanarToChunky = void (*)(const u8* planar, u8* chunky, u8* chunky_hflip, int rows);
+
+    struct PlanarKernel {
+        const char* name;
+        PlanarToChunky convert;
+    };
+
+    // The reference the others are checked against
+    void planar_to_chunky_scalar(const u8* planar, u8* chunky, u8* chunky_hflip, int rows);
+
+    // The kernels this CPU can run, fastest first
+    std::vector<PlanarKernel> planar_kernels();
+
+    // The fastest kernel this CPU can run, chosen at startup
+    extern const PlanarToChunky planar_to_chunky;
+}
+
+#endif //SMS_VDP_PLANAR_H
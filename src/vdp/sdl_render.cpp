@@ -2,6 +2,9 @@
 
 #include <util/log.h>
 #include <util/types.h>
+#include <util/triple_buffer.h>
+#include <input/input.h>
+#include <atomic>
 #include <cassert>
 #include "vdp_register.h"
 #include "vdp.h"
@@ -15,59 +18,141 @@ namespace Vdp {
 
     constexpr int SCREEN_SCALE = 4;
 
-    void render_init() {
-        SDL_Init(SDL_INIT_VIDEO);
+    const SDL_Rect active_area {0, 0, SMS_SCREEN_X, SMS_ACTIVE_LINES};
+
+    typedef u32 Frame[SMS_ACTIVE_LINES][SMS_SCREEN_X];
+    // Frames go from whichever thread draws them to the main thread through here, so neither waits for the other
+    Util::TripleBuffer<Frame> frames;
+    // Pushed to wake the presenter when there's a frame to show, or it's time to stop
+    u32 wake_event;
+    std::atomic<bool> wake_pending = false;
+    std::atomic<bool> stopping = false;
+
+    bool key_button(SDL_Keycode key, Input::Button& button) {
+        switch (key) {
+            case SDLK_UP: button = Input::Button::Up; return true;
+            case SDLK_DOWN: button = Input::Button::Down; return true;
+            case SDLK_LEFT: button = Input::Button::Left; return true;
+            case SDLK_RIGHT: button = Input::Button::Right; return true;
+            case SDLK_z: button = Input::Button::Button1; return true;
+            case SDLK_x: button = Input::Button::Button2; return true;
+            default: return false;
+        }
+    }
+
+    void handle_event(const SDL_Event& event) {
+        Input::Button button;
+        switch (event.type) {
+            case SDL_QUIT:
+                Input::send({Input::Event::Quit});
+                break;
+            case SDL_KEYDOWN:
+                if (event.key.keysym.sym == SDLK_ESCAPE) {
+                    Input::send({Input::Event::Quit});
+                } else if (key_button(event.key.keysym.sym, button)) {
+                    Input::send({Input::Event::Press, button});
+                }
+                break;
+            case SDL_KEYUP:
+                if (key_button(event.key.keysym.sym, button)) {
+                    Input::send({Input::Event::Release, button});
+                }
+                break;
+        }
+    }
+
+    void open_window() {
+        if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+            logdie("Couldn't initialise SDL video: %s", SDL_GetError());
+        }
         window = SDL_CreateWindow("dgb sms",
                                   SDL_WINDOWPOS_UNDEFINED,
                                   SDL_WINDOWPOS_UNDEFINED,
                                   SMS_SCREEN_X * SCREEN_SCALE,
                                   SMS_SCREEN_Y * SCREEN_SCALE,
                                   SDL_WINDOW_SHOWN);
+        if (!window) {
+            logdie("Couldn't open a window: %s", SDL_GetError());
+        }
         renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        if (!renderer) {
+            logdie("Couldn't create a renderer: %s", SDL_GetError());
+        }
         buffer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, SMS_SCREEN_X, SMS_SCREEN_Y);
+        if (!buffer) {
+            logdie("Couldn't create the screen texture: %s", SDL_GetError());
+        }
         SDL_RenderSetScale(renderer, SCREEN_SCALE, SCREEN_SCALE);
+        wake_event = SDL_RegisterEvents(1);
+        if (wake_event == (u32)-1) {
+            logdie("Couldn't register an SDL event: %s", SDL_GetError());
+        }
     }
 
-    u32 fullcolor_screen[SMS_SCREEN_Y][SMS_SCREEN_X];
-
-    u32 convert_color_channel(u8 channel) {
-        switch (channel & 0b11) {
-            case 0b00: return 0x00;
-            case 0b01: return 0x0F;
-            case 0b10: return 0xF0;
-            case 0b11: return 0xFF;
+    // Safe from any thread. Only one wake-up is queued at a time, so frames coming faster than they can be shown
+    // don't fill SDL's event queue.
+    void wake_presenter() {
+        if (!wake_pending.exchange(true, std::memory_order_acq_rel)) {
+            SDL_Event event {};
+            event.type = wake_event;
+            if (SDL_PushEvent(&event) != 1) {
+                // Dropped, so the next frame tries again
+                wake_pending.store(false, std::memory_order_release);
+            }
         }
-        logfatal("oop");
     }
 
-    //  --BBGGRR
-    inline u32 smscolor_to_sdlcolor(u8 color) {
-        u32 red = convert_color_channel(color >> 0);
-        u32 green = convert_color_channel(color >> 2);
-        u32 blue = convert_color_channel(color >> 4);
-        return (red << 24) | (green << 16) | (blue << 8);
+    void show_latest_frame() {
+        if (frames.update()) {
+            SDL_UpdateTexture(buffer, &active_area, frames.front(), SMS_SCREEN_X * sizeof(u32));
+            SDL_RenderClear(renderer);
+            SDL_RenderCopy(renderer, buffer, &active_area, &active_area);
+            SDL_RenderPresent(renderer);
+        }
     }
 
-    void render_frame() {
-        for (int x = 0; x < SMS_SCREEN_X; x++) {
-            for (int y = 0; y < SMS_SCREEN_Y; y++) {
-                fullcolor_screen[y][x] = smscolor_to_sdlcolor(screen[y][x]);
-            }
-        }
-        SDL_UpdateTexture(buffer, nullptr, screen, SMS_SCREEN_X * 4);
-        SDL_RenderCopy(renderer, buffer, nullptr, nullptr);
-        SDL_RenderPresent(renderer);    SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            switch (event.type) {
-                case SDL_QUIT:
-                    exit(0);
-                case SDL_KEYDOWN:
-                    switch (event.key.keysym.sym) {
-                        case SDLK_ESCAPE:
-                            exit(0);
-                    }
-                    break;
+    void present_frames() {
+        while (!stopping.load(std::memory_order_acquire)) {
+            SDL_Event event;
+            if (!SDL_WaitEvent(&event)) {
+                logdie("Couldn't wait for SDL events: %s", SDL_GetError());
             }
+            do {
+                if (event.type == wake_event) {
+                    // Cleared before looking for a frame, so one published after this wakes it again
+                    wake_pending.store(false, std::memory_order_release);
+                } else {
+                    handle_event(event);
+                }
+            } while (SDL_PollEvent(&event));
+            show_latest_frame();
         }
+        // The frame published just before stopping
+        show_latest_frame();
+    }
+
+    void stop_presenting() {
+        stopping.store(true, std::memory_order_release);
+        // If a wake-up is already queued, the presenter sees this once it's handled that
+        wake_presenter();
+    }
+
+    void close_window() {
+        SDL_DestroyTexture(buffer);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        buffer = nullptr;
+        renderer = nullptr;
+        window = nullptr;
+    }
+
+    u32* frame_line(unsigned int line) {
+        return frames.back()[line];
+    }
+
+    void render_frame() {
+        frames.publish();
+        wake_presenter();
     }
 }
@@ -1,9 +1,25 @@
 #ifndef SMS_SDL_RENDER_H
 #define SMS_SDL_RENDER_H
 
+#include <util/types.h>
+
 namespace Vdp {
+    // The window, and SDL's event handling, belong to the main thread: SDL doesn't support them anywhere else. The
+    // emulator runs on another thread and hands frames over through render_frame().
+
+    // Opens the window. Call on the main thread.
+    void open_window();
+    // On the main thread: shows each frame as it's handed over, at most at the display's refresh rate, and sends input
+    // to the emulator. Returns once stop_presenting() has been called, after showing the last frame.
+    void present_frames();
+    // Safe from any thread
+    void stop_presenting();
+    // Closes the window and shuts SDL down. Call on the main thread, after present_frames() has returned.
+    void close_window();
+    // Where to draw a line of the frame, in RGBA8888. Every line has to be drawn each frame.
+    u32* frame_line(unsigned int line);
+    // Hands the frame over to be presented. Never waits.
     void render_frame();
-    void render_init();
 }
 
 #endif //SMS_SDL_RENDER_H
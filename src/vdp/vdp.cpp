@@ -1,8 +1,17 @@
 #include <util/log.h>
+#include <util/spsc_queue.h>
+#include <scheduler/scheduler.h>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <utility>
 #include "vdp.h"
 #include "vdp_register.h"
-#include "sdl_render.h"
+#include "planar.h"
+#include "video_sink.h"
 
 namespace Vdp {
     bool ctrl_high = false;
@@ -10,46 +19,186 @@ namespace Vdp {
     u16 address;
     u8 read_buffer;
 
-    u8 vram[0x4000];
-    u8 cram[32];
+    VideoMemory memory;
 
-    u8 screen[256][256];
+    u64 frame_count = 0;
+    bool present_frame = true;
+
+    RenderSkip render_skip = RenderSkip::Off;
+    u64 render_skip_n = 1;
+    bool frame_requested = false;
+    // Whether the frame is being drawn, decided as it starts
+    bool drawing_frame = true;
 
-    int cycle_counter = 0;
-    int hcounter = 0;
     int vcounter = 0;
+    // When the current line ends, in master clock cycles
+    u64 line_end = 0;
     u8 line_counter = 0;
 
     bool line_interrupt = false;
     bool frame_interrupt = false;
 
     constexpr int num_scanlines = 262;
-    constexpr int fps = 60;
-    constexpr int cycles_per_line = 3579545 / num_scanlines / fps;
+    // The line the frame interrupt is raised at the end of
+    constexpr int frame_interrupt_line = 224;
+    // In master clock cycles, which is exactly 228 CPU cycles
+    constexpr int cycles_per_line = 3420;
+    constexpr int cycles_per_pixel = 10;
+    constexpr int cycles_per_frame = cycles_per_line * num_scanlines;
 
     constexpr int COMMAND_VRAM_READ = 0;
     constexpr int COMMAND_VRAM_WRITE = 1;
     constexpr int COMMAND_REGISTER_WRITE = 2;
     constexpr int COMMAND_CRAM_WRITE = 3;
 
+    void frame_interrupt_event(u64 time);
+
+    // What the VDP sends the render thread: the lines to draw, and the writes to video memory between them
+    struct RenderCommand {
+        enum Type : u8 {
+            Line,
+            VramWrite,
+            CramWrite,
+            Frame,
+        } type;
+        u8 value;
+        // The line for Line
+        u16 address;
+    };
+
+    bool render_on_thread = false;
+    Util::SpscQueue<RenderCommand, 0x10000> render_queue;
+    // The render thread's copy, so the CPU thread can carry on writing to the real one
+    VideoMemory thread_memory;
+    // The CPU thread waits rather than getting further ahead than this, so what's on screen doesn't lag behind
+    constexpr u32 max_frames_ahead = 2;
+    u32 frames_queued = 0;
+    std::atomic<u32> frames_rendered = 0;
+
+    void VideoMemory::decode_patterns() {
+        // Each pattern row is 4 bytes of VRAM, one per bitplane, and 8 bytes decoded
+        for (unsigned int word = 0; word < std::size(dirty_rows); word++) {
+            u64 dirty = dirty_rows[word];
+            dirty_rows[word] = 0;
+            while (dirty) {
+                int first = std::countr_zero(dirty);
+                int length = std::countr_one(dirty >> first);
+                int row = word * 64 + first;
+                planar_to_chunky(&vram[row * 4], &patterns[0][0][0] + row * 8, &patterns_hflip[0][0][0] + row * 8,
+                                 length);
+                dirty = length == 64 ? 0 : dirty & ~(((1ull << length) - 1) << first);
+            }
+        }
+    }
+
+    u32 convert_color_channel(u8 channel) {
+        switch (channel & 0b11) {
+            case 0b00: return 0x00;
+            case 0b01: return 0x0F;
+            case 0b10: return 0xF0;
+            case 0b11: return 0xFF;
+        }
+        logfatal("oop");
+    }
+
+    //  --BBGGRR
+    u32 smscolor_to_rgba(u8 color) {
+        u32 red = convert_color_channel(color >> 0);
+        u32 green = convert_color_channel(color >> 2);
+        u32 blue = convert_color_channel(color >> 4);
+        return (red << 24) | (green << 16) | (blue << 8) | 0xFF;
+    }
+
+    void VideoMemory::update_palette() {
+        if (palette_changed) {
+            for (int i = 0; i < 32; i++) {
+                palette[i] = smscolor_to_rgba(cram[i]);
+            }
+            palette_changed = false;
+        }
+    }
+
+    void render_thread_main() {
+        video_sink->init();
+        RenderCommand command;
+        while (true) {
+            if (!render_queue.pop(command)) {
+                render_queue.wait();
+                continue;
+            }
+            switch (command.type) {
+                case RenderCommand::Line:
+                    render_scanline_mode4(thread_memory, command.address);
+                    break;
+                case RenderCommand::VramWrite:
+                    thread_memory.write_vram(command.address, command.value);
+                    break;
+                case RenderCommand::CramWrite:
+                    thread_memory.write_cram(command.address, command.value);
+                    break;
+                case RenderCommand::Frame:
+                    video_sink->present();
+                    frames_rendered.fetch_add(1, std::memory_order_release);
+                    frames_rendered.notify_one();
+                    break;
+            }
+        }
+    }
+
+    void start_render_thread() {
+        thread_memory = memory;
+        render_on_thread = true;
+        // Nothing reads the sprite status bits yet, so the CPU never has to wait for the renderer. It runs until the
+        // program exits.
+        std::thread(render_thread_main).detach();
+    }
+
+    void finish_rendering() {
+        if (render_on_thread) {
+            for (u32 rendered; (rendered = frames_rendered.load()) != frames_queued;) {
+                frames_rendered.wait(rendered);
+            }
+        }
+    }
+
+    void set_render_skip(RenderSkip skip, u64 n) {
+        render_skip = skip;
+        render_skip_n = n;
+    }
+
+    void request_frame() {
+        frame_requested = true;
+    }
+
+    bool should_draw_frame(u64 frame) {
+        switch (render_skip) {
+            case RenderSkip::Off:
+                return present_frame;
+            case RenderSkip::EveryNth:
+                return frame % render_skip_n == render_skip_n - 1;
+            case RenderSkip::LastFrame:
+                return frame == render_skip_n - 1;
+            case RenderSkip::OnRequest:
+                return std::exchange(frame_requested, false);
+        }
+        return true;
+    }
+
     void reset() {
         line_counter = 0xFF;
-        cycle_counter = 0;
-        hcounter = 0;
         vcounter = 0;
-        for (int i = 0; i < 0x4000; i++) {
-            vram[i] = 0;
-        }
+        line_end = Scheduler::now + cycles_per_line;
+        memory = {};
+        memory.palette_changed = true;
 
-        for (int i = 0; i < 32; i++) {
-            cram[i] = 0;
-        }
+        Scheduler::schedule(Scheduler::Event::VdpFrameInterrupt,
+                            Scheduler::now + (frame_interrupt_line + 1) * cycles_per_line, frame_interrupt_event);
     }
 
     void process_command() {
         switch (code) {
             case COMMAND_VRAM_READ:
-                read_buffer = vram[address];
+                read_buffer = memory.vram[address];
                 address++;
                 break;
             case COMMAND_VRAM_WRITE: // Handled in the write_data() function below
@@ -83,11 +232,17 @@ namespace Vdp {
         switch (code) {
             case COMMAND_REGISTER_WRITE:
             case COMMAND_VRAM_WRITE:
-                vram[address & 0x3FFF] = value;
+                memory.write_vram(address & 0x3FFF, value);
+                if (render_on_thread) {
+                    render_queue.push_wait({RenderCommand::VramWrite, value, (u16)(address & 0x3FFF)});
+                }
                 address = (address + 1) & 0x3FFF;
                 break;
             case COMMAND_CRAM_WRITE:
-                cram[address & 0x1F] = value & 0x3F;
+                memory.write_cram(address & 0x1F, value & 0x3F);
+                if (render_on_thread) {
+                    render_queue.push_wait({RenderCommand::CramWrite, (u8)(value & 0x3F), (u16)(address & 0x1F)});
+                }
                 address = (address + 1) & 0x3FFF;
                 break;
             default:
@@ -95,7 +250,19 @@ namespace Vdp {
         }
     }
 
-    void render_scanline_mode4(unsigned int line) {
+    // Colour index of each pixel of a line: the CRAM address in the low 5 bits, and the background's priority bit above
+    constexpr u8 INDEX_CRAM_MASK = 0x1F;
+
+    void render_scanline_mode4(VideoMemory& memory, unsigned int line) {
+        u32* out = video_sink->frame_line(line);
+        if (!out) {
+            return;
+        }
+        memory.decode_patterns();
+        memory.update_palette();
+
+        alignas(8) u8 indices[SMS_SCREEN_X];
+
         // Tiles are 8x8, divide our line by 8 to get our y offset into the nametable
         unsigned int tile_y = line / 8;
         unsigned int intile_y = line % 8;
@@ -111,58 +278,47 @@ namespace Vdp {
             u16 addr  = nametable_address | (tile_x << 1);
 
 
-            u16 entry = vram[addr] | ((u16)vram[addr + 1] << 8);
+            u16 entry = memory.vram[addr] | ((u16)memory.vram[addr + 1] << 8);
 
             // pcvhnnnnnnnnn
 
-            u16 pattern_index = ((entry & 0x1FF) * 32) + (intile_y * 4);
             bool hflip = (entry >> 9) & 1;
             bool vflip = (entry >> 10) & 1;
             if (vflip) {
                 logfatal("vflip!");
             }
-            int palette = (entry >> 11) & 1;
-            if (palette != 0) {
-                logfatal("Second palette selected");
-            }
-            //bool priority = (entry >> 12) & 1;
-
-            u8 bp[] {
-                    vram[pattern_index + 0],
-                    vram[pattern_index + 1],
-                    vram[pattern_index + 2],
-                    vram[pattern_index + 3],
-            };
-
-            for (int pixel = 0; pixel < 8; pixel++) {
-                int bit = hflip ? pixel : 7 - pixel;
+            // The palette bit selects the upper 16 colours, and the priority bit goes above it
+            u64 attributes = ((entry >> 7) & 0x30) * 0x0101010101010101;
+
+            const u8* pattern = hflip ? memory.patterns_hflip[entry & 0x1FF][intile_y]
+                                      : memory.patterns[entry & 0x1FF][intile_y];
+            u64 row;
+            memcpy(&row, pattern, sizeof(row));
+            row |= attributes;
+            memcpy(&indices[tile_x * 8], &row, sizeof(row));
+        }
 
-                u8 color_index = 0;
-                for (int bpindex = 0; bpindex < 4; bpindex++) {
-                    color_index |= ((bp[bpindex] >> bit) & 1) << bpindex;
-                }
-                if (color_index > 32) {
-                    logfatal("Color index %d too beeg", color_index);
-                }
-                screen[line][tile_x * 8 + pixel] = cram[color_index];
-            }
+        for (int x = 0; x < SMS_SCREEN_X; x++) {
+            out[x] = memory.palette[indices[x] & INDEX_CRAM_MASK];
         }
     }
 
 
     void scanline() {
+        if (vcounter == 0) {
+            drawing_frame = should_draw_frame(frame_count);
+        }
         switch (mode.raw) {
             case 0b1010:
                 //printf("Mode 4. If you see this more than once, implement me!\n");
                 //break;
             case 0b1011:
-                if (vcounter <= 192) {
-                    render_scanline_mode4(vcounter);
-                }
-                // TODO does this happen at 224 or 225?
-                if (vcounter == 224 && vdpModeControl1[VdpModeControl2::FrameInterruptEnable]) {
-                    render_frame();
-                    frame_interrupt = true;
+                if (vcounter < SMS_ACTIVE_LINES && drawing_frame) {
+                    if (render_on_thread) {
+                        render_queue.push_wait({RenderCommand::Line, 0, (u16)vcounter});
+                    } else {
+                        render_scanline_mode4(memory, vcounter);
+                    }
                 }
                 break;
             default:
@@ -179,12 +335,41 @@ namespace Vdp {
         vcounter = (vcounter + 1) % num_scanlines;
     }
 
-    void step(unsigned int cycles) {
-        cycle_counter += cycles;
-        if (cycle_counter >= cycles_per_line) {
-            cycle_counter -= cycles_per_line;
+    void catch_up(u64 time) {
+        while (line_end <= time) {
             scanline();
+            line_end += cycles_per_line;
+        }
+    }
+
+    u8 get_hcounter(u64 time) {
+        catch_up(time);
+        // Half the pixel, in the order the NTSC VDP counts them: 0x00 to 0x93, then 0xE9 to 0xFF
+        int pixel = (time - (line_end - cycles_per_line)) / cycles_per_pixel;
+        int hcounter = pixel / 2;
+        return hcounter > 0x93 ? hcounter + 0xE9 - 0x94 : hcounter;
+    }
+
+    // At the end of frame_interrupt_line
+    void frame_interrupt_event(u64 time) {
+        catch_up(time);
+        // TODO does this happen at 224 or 225?
+        frame_count++;
+        if (vdpModeControl1[VdpModeControl2::FrameInterruptEnable]) {
+            if (drawing_frame && render_on_thread) {
+                render_queue.push_wait({RenderCommand::Frame, 0, 0});
+                // The render thread only wakes up once a frame's worth has been queued
+                render_queue.notify();
+                frames_queued++;
+                for (u32 rendered; frames_queued - (rendered = frames_rendered.load()) > max_frames_ahead;) {
+                    frames_rendered.wait(rendered);
+                }
+            } else if (drawing_frame) {
+                video_sink->present();
+            }
+            frame_interrupt = true;
         }
+        Scheduler::schedule(Scheduler::Event::VdpFrameInterrupt, time + cycles_per_frame, frame_interrupt_event);
     }
 
     bool interrupt_pending() {
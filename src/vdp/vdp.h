@@ -4,22 +4,81 @@
 #include <util/types.h>
 
 namespace Vdp {
-    extern u8 vram[0x4000];
-    extern u8 cram[32];
-    extern u8 screen[256][256];
+    // Everything the renderer reads. The render thread has a copy of its own, kept up to date through a queue.
+    struct VideoMemory {
+        u8 vram[0x4000];
+        u8 cram[32];
+        // CRAM converted to RGBA8888. Only up to date after update_palette().
+        u32 palette[32];
+        bool palette_changed;
+        // The 512 patterns decoded to a colour index per pixel, as they are and flipped horizontally. Only up to date
+        // after decode_patterns().
+        u8 patterns[512][8][8];
+        u8 patterns_hflip[512][8][8];
+        // A bit for each pattern row written to since the last decode_patterns()
+        u64 dirty_rows[0x4000 / 4 / 64];
 
+        void write_vram(u16 address, u8 value) {
+            vram[address] = value;
+            dirty_rows[address / 256] |= 1ull << ((address / 4) % 64);
+        }
+
+        void write_cram(u8 address, u8 value) {
+            cram[address] = value;
+            palette_changed = true;
+        }
+
+        // Decodes the rows that have changed, a run of them at a time
+        void decode_patterns();
+        void update_palette();
+    };
+
+    extern VideoMemory memory;
+
+    // Frames finished so far
+    extern u64 frame_count;
+    // Whether the next frame is shown, or dropped to save time
+    extern bool present_frame;
+
+    // Which frames are drawn. The rest still keep all the timing, interrupt and status state, but don't draw a pixel.
+    enum class RenderSkip {
+        // Every frame that's presented
+        Off,
+        // Every nth frame
+        EveryNth,
+        // Only frame n - 1, for running a fixed number of frames
+        LastFrame,
+        // Only the frames after calls to request_frame()
+        OnRequest,
+    };
+
+    // Only up to date after catch_up()
     extern int vcounter;
     extern u8 read_buffer;
 
     constexpr int SMS_SCREEN_X = 256;
     constexpr int SMS_SCREEN_Y = 256;
+    // Lines of the screen that are drawn, the rest being border
+    constexpr int SMS_ACTIVE_LINES = 192;
 
+    // Resets the VDP and schedules its events. Call Scheduler::reset() first.
     void reset();
+    // Renders on a thread of its own from now on, instead of while the CPU waits. Call after reset().
+    void start_render_thread();
+    // Waits for the render thread to present every frame it's been sent
+    void finish_rendering();
+    void set_render_skip(RenderSkip skip, u64 n = 1);
+    // Draws the next frame to start, with RenderSkip::OnRequest
+    void request_frame();
     void write_control(u8 value);
     void write_data(u8 value);
-    void step(unsigned int cycles);
+    // The VDP runs behind the CPU, and only renders the lines it's missed when something could see the difference.
+    // This runs it up to `time`, in master clock cycles. Call it before any access to its ports.
+    void catch_up(u64 time);
     bool interrupt_pending();
     u8 get_status();
+    u8 get_hcounter(u64 time);
+    void render_scanline_mode4(VideoMemory& memory, unsigned int line);
 }
 
 #endif //SMS_VDP_H
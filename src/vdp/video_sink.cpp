@@ -0,0 +1,48 @@
+#include <cstring>
+#include <initializer_list>
+#include "video_sink.h"
+#include "sdl_render.h"
+#include "vdp.h"
+
+namespace Vdp {
+    // The window is opened by main(), on the main thread
+    const VideoSink sdl_sink {"sdl", [] {}, frame_line, render_frame};
+
+    const VideoSink null_sink {
+            "null",
+            [] {},
+            [](unsigned int line) -> u32* { return nullptr; },
+            [] {},
+    };
+
+    u32 memory_frame[SMS_ACTIVE_LINES][SMS_SCREEN_X];
+    frame_handler memory_frame_handler = nullptr;
+    void* memory_frame_context = nullptr;
+
+    void set_frame_handler(frame_handler handler, void* context) {
+        memory_frame_handler = handler;
+        memory_frame_context = context;
+    }
+
+    const VideoSink memory_sink {
+            "memory",
+            [] {},
+            [](unsigned int line) -> u32* { return memory_frame[line]; },
+            [] {
+                if (memory_frame_handler) {
+                    memory_frame_handler(memory_frame_context, &memory_frame[0][0], SMS_SCREEN_X, SMS_ACTIVE_LINES);
+                }
+            },
+    };
+
+    const VideoSink* video_sink = &sdl_sink;
+
+    const VideoSink* find_video_sink(const char* name) {
+        for (const VideoSink* sink : {&sdl_sink, &null_sink, &memory_sink}) {
+            if (!strcmp(sink->name, name)) {
+                return sink;
+            }
+        }
+        return nullptr;
+    }
+}
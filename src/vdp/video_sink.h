@@ -0,0 +1,35 @@
+#ifndef SMS_VIDEO_SINK_H
+#define SMS_VIDEO_SINK_H
+
+#include <util/types.h>
+
+namespace Vdp {
+    // Where the VDP sends what it draws. These are all called on the thread that renders.
+    struct VideoSink {
+        const char* name;
+        void (*init)();
+        // Where to draw a line of the frame, in RGBA8888. nullptr if nothing would look at it, so it isn't drawn.
+        u32* (*frame_line)(unsigned int line);
+        // Called once all the frame's lines have been drawn
+        void (*present)();
+    };
+
+    // A window, presented at the display's refresh rate. See sdl_render.h for the main thread's side of it.
+    extern const VideoSink sdl_sink;
+    // Draws nothing, so the emulator runs as fast as it can without a window
+    extern const VideoSink null_sink;
+    // Hands each frame to the frame handler
+    extern const VideoSink memory_sink;
+
+    // SDL unless another is chosen before the VDP starts rendering
+    extern const VideoSink* video_sink;
+
+    // Returns the sink called `name`, or nullptr if there isn't one
+    const VideoSink* find_video_sink(const char* name);
+
+    // Called by the memory sink with each frame, which is only valid until it returns
+    typedef void (*frame_handler)(void* context, const u32* pixels, int width, int height);
+    void set_frame_handler(frame_handler handler, void* context = nullptr);
+}
+
+#endif //SMS_VIDEO_SINK_H
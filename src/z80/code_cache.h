@@ -0,0 +1,264 @@
+#ifndef SMS_Z80_CODE_CACHE_H
+#define SMS_Z80_CODE_CACHE_H
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "util/types.h"
+
+namespace Z80 {
+    template <typename Bus>
+    struct Core;
+
+    template <typename Bus>
+    using instruction = int (*)(Core<Bus>& cpu);
+
+    // Code is cached per 1KB page of host memory. The bus maps guest addresses to these pages with code_page(), so a
+    // page's blocks are shared by every address it's mapped at, and a bank switch just maps a different set of blocks.
+    constexpr int CODE_PAGE_SHIFT = 10;
+    constexpr int CODE_PAGE_SIZE = 1 << CODE_PAGE_SHIFT;
+    constexpr int CODE_PAGE_MASK = CODE_PAGE_SIZE - 1;
+    constexpr int NUM_CODE_PAGES = 0x10000 >> CODE_PAGE_SHIFT;
+
+    inline constexpr u8 NO_CODE[CODE_PAGE_SIZE] = {};
+
+    constexpr int MAX_INSTRUCTION_LENGTH = 4;
+    constexpr int MAX_BLOCK_INSTRUCTIONS = 32;
+
+    // An instruction with its prefixes resolved to the final handler and its operands already read
+    template <typename Bus>
+    struct DecodedInstruction {
+        instruction<Bus> handler;
+        // 0 if there isn't a prefix, otherwise 0xCB, 0xDD, 0xED, 0xFD, 0xDDCB or 0xFDCB
+        u16 prefix;
+        u8 opcode;
+        u8 length;
+        // Offset of the next instruction from the start of the block. pc is set to this before the handler is called,
+        // as the interpreter would have left it after reading the operands.
+        u8 end;
+        // for DDCB and FDCB
+        s8 displacement;
+        u8 operands[2];
+    };
+
+    // A run of instructions that ends at the first one that can jump
+    template <typename Bus>
+    struct Block {
+        int length;
+        std::vector<DecodedInstruction<Bus>> instructions;
+
+        // The last blocks run after this one, so loops can go from block to block without a lookup. Only valid while
+        // links_epoch matches the cache's epoch.
+        Block* links[2];
+        u16 link_addresses[2];
+        u32 links_epoch;
+
+        // Set once the JIT has translated the block
+        int (*native)(Core<Bus>* cpu, int executed_cycles);
+        u32 runs;
+    };
+
+    template <typename Bus>
+    struct CodePage {
+        std::unique_ptr<Block<Bus>> blocks[CODE_PAGE_SIZE];
+        // How many blocks contain each byte, so writes to data can skip looking for blocks to invalidate
+        u8 coverage[CODE_PAGE_SIZE] = {};
+    };
+
+    template <typename Bus>
+    class CodeCache {
+    public:
+        // Returns the block starting at address, decoding it if needed. An empty block means the instruction there
+        // can't be cached and has to be interpreted.
+        Block<Bus>* lookup(Bus& bus, u16 address) {
+            const u8* host = bus.code_page(address);
+            int index = address >> CODE_PAGE_SHIFT;
+            if (host && host == mapped_host[index] && mapped_page[index]) {
+                if (Block<Bus>* block = mapped_page[index]->blocks[address & CODE_PAGE_MASK].get()) {
+                    return block;
+                }
+            }
+            return lookup_slow(host, address);
+        }
+
+        // Looks up the block at address, which is where `from` left off
+        Block<Bus>* next(Bus& bus, Block<Bus>* from, u16 address) {
+            if (from->links_epoch == epoch) {
+                if (from->link_addresses[0] == address) {
+                    return from->links[0];
+                }
+                if (from->link_addresses[1] == address) {
+                    return from->links[1];
+                }
+            } else {
+                from->links[0] = from->links[1] = nullptr;
+                from->links_epoch = epoch;
+            }
+
+            Block<Bus>* block = lookup(bus, address);
+            if (block && !block->instructions.empty()) {
+                from->links[1] = from->links[0];
+                from->link_addresses[1] = from->link_addresses[0];
+                from->links[0] = block;
+                from->link_addresses[0] = address;
+            }
+            return block;
+        }
+
+        // Drops any blocks containing address. Returns true if there were any.
+        bool invalidate(Bus& bus, u16 address) {
+            int index = address >> CODE_PAGE_SHIFT;
+            const u8* coverage = write_coverage[index];
+            if (!coverage) {
+                coverage = find_write_coverage(bus, address);
+            }
+            if (!coverage[address & CODE_PAGE_MASK]) {
+                return false;
+            }
+            invalidate_blocks(write_page[index], address & CODE_PAGE_MASK);
+            return true;
+        }
+
+        // Returns true if any blocks contain the `length` bytes at address, which mustn't cross a page
+        bool contains_code(Bus& bus, u16 address, int length) {
+            int index = address >> CODE_PAGE_SHIFT;
+            const u8* coverage = write_coverage[index];
+            if (!coverage) {
+                coverage = find_write_coverage(bus, address);
+            }
+            const u8* start = coverage + (address & CODE_PAGE_MASK);
+            return std::any_of(start, start + length, [](u8 count) { return count != 0; });
+        }
+
+        // Frees invalidated blocks. Only call this between blocks.
+        void release_retired() {
+            retired.clear();
+        }
+
+        // Forgets everything that depends on the memory map, for when it changes
+        void unlink() {
+            epoch++;
+            std::fill(std::begin(write_coverage), std::end(write_coverage), nullptr);
+        }
+
+        void flush();
+
+    private:
+        CodePage<Bus>* find_page(const u8* host, u16 address, bool create) {
+            int index = address >> CODE_PAGE_SHIFT;
+            if (mapped_host[index] != host || (!mapped_page[index] && create)) {
+                remap(host, index, create);
+            }
+            return mapped_page[index];
+        }
+
+        void remap(const u8* host, int index, bool create);
+        const u8* find_write_coverage(Bus& bus, u16 address);
+        Block<Bus>* lookup_slow(const u8* host, u16 address);
+        void invalidate_blocks(CodePage<Bus>* page, int offset);
+        std::unique_ptr<Block<Bus>> decode_block(const u8* host, int offset);
+
+        std::unordered_map<const u8*, std::unique_ptr<CodePage<Bus>>> pages;
+        // The page last seen at each guest page, to skip the hash lookup while the mapping stays the same
+        const u8* mapped_host[NUM_CODE_PAGES] = {};
+        CodePage<Bus>* mapped_page[NUM_CODE_PAGES] = {};
+        // Coverage of the page at each guest page, looked up on the first write to it since the memory map last
+        // changed. Pages without any code point at NO_CODE.
+        const u8* write_coverage[NUM_CODE_PAGES] = {};
+        CodePage<Bus>* write_page[NUM_CODE_PAGES] = {};
+        // Invalidated blocks might still be executing, so they're only freed at the next lookup
+        std::vector<std::unique_ptr<Block<Bus>>> retired;
+        u32 epoch = 1;
+    };
+
+    // Operand bytes following an unprefixed opcode
+    constexpr int operand_length(u8 opcode) {
+        switch (opcode) {
+            case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x36: case 0x3E: // ld r, n
+            case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE: // alu n
+            case 0x10: case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // djnz, jr
+            case 0xD3: case 0xDB: // out (n), a / in a, (n)
+                return 1;
+            case 0x01: case 0x11: case 0x21: case 0x31: // ld rr, nn
+            case 0x22: case 0x2A: case 0x32: case 0x3A: // ld (nn), hl / ld hl, (nn) / ld (nn), a / ld a, (nn)
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE2: case 0xEA: case 0xF2: case 0xFA: // jp
+            case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC: case 0xE4: case 0xEC: case 0xF4: case 0xFC: // call
+                return 2;
+            default:
+                return 0;
+        }
+    }
+
+    // Opcodes that use (HL), which become (IX+d) / (IY+d) after a DD / FD prefix
+    constexpr bool uses_index_displacement(u8 opcode) {
+        switch (opcode) {
+            case 0x34: case 0x35: case 0x36:
+            case 0x46: case 0x4E: case 0x56: case 0x5E: case 0x66: case 0x6E: case 0x7E:
+            case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x77:
+            case 0x86: case 0x8E: case 0x96: case 0x9E: case 0xA6: case 0xAE: case 0xB6: case 0xBE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    constexpr int ed_operand_length(u8 opcode) {
+        switch (opcode) {
+            case 0x43: case 0x4B: case 0x53: case 0x5B: case 0x63: case 0x6B: case 0x73: case 0x7B: // ld (nn), rr
+                return 2;
+            default:
+                return 0;
+        }
+    }
+
+    // Instructions that can change pc other than by stepping over themselves end a block
+    constexpr bool ends_block(u8 opcode) {
+        switch (opcode) {
+            case 0x10: case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // djnz, jr
+            case 0x76: // halt
+            case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xE0: case 0xE8: case 0xF0: case 0xF8: // ret
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE2: case 0xEA: case 0xF2: case 0xFA: // jp
+            case 0xE9: // jp (hl)
+            case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC: case 0xE4: case 0xEC: case 0xF4: case 0xFC: // call
+            case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF: // rst
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Handlers that look at Core::cycles_left() or Core::cycles_run(), so the cycle count has to be stored before
+    // they're called
+    constexpr bool uses_cycle_count(u16 prefix, u8 opcode) {
+        if (prefix == 0xED) {
+            return true;
+        }
+        if (prefix != 0 && prefix != 0xDD && prefix != 0xFD) {
+            return false;
+        }
+        switch (opcode) {
+            case 0x76: // halt
+            case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // jr, for idle loops
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE2: case 0xEA: case 0xF2: case 0xFA: // jp
+            case 0xD3: case 0xDB: // out (n), a / in a, (n), for the bus to time port accesses
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    constexpr bool ed_ends_block(u8 opcode) {
+        switch (opcode) {
+            case 0x45: case 0x4D: case 0x55: case 0x5D: case 0x65: case 0x6D: case 0x75: case 0x7D: // retn, reti
+            case 0xB0: case 0xB1: case 0xB2: case 0xB3: case 0xB8: case 0xB9: case 0xBA: case 0xBB: // block repeats
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+#endif //SMS_Z80_CODE_CACHE_H
@@ -0,0 +1,800 @@
+#ifndef SMS_Z80_CORE_H
+#define SMS_Z80_CORE_H
+
+#include <algorithm>
+
+#include "z80.h"
+
+#include "util/log.h"
+
+#include "instructions.h"
+#include "util.h"
+
+namespace Z80 {
+    template <typename Bus>
+    void Core<Bus>::reset() {
+        static_cast<CpuState&>(*this) = CpuState {};
+        a = 0xFF;
+        f.set(0xFF);
+        sp = 0xFFFF;
+    }
+
+    template <typename Bus>
+    void Core<Bus>::set_mode(Mode new_mode) {
+        if (new_mode == Mode::Cached && !has_code_pages) {
+            logfatal("The cached mode needs a bus with code_page()");
+        }
+        if (new_mode == Mode::Jit && (!has_code_pages || !JIT_SUPPORTED)) {
+            logfatal("The JIT needs x86-64 and a bus with code_page()");
+        }
+        mode = new_mode;
+    }
+
+    template <typename Bus>
+    void Core<Bus>::service_interrupt() {
+        if (halted) {
+            // Return to the instruction after the halt
+            halted = false;
+            pc++;
+        }
+        interrupts_enabled = false;
+        next_interrupts_enabled = false;
+        switch (interrupt_mode) {
+            case 1:
+                stack_push<u16>(*this, pc);
+                pc = 0x0038;
+                break;
+            default:
+                logfatal("Interrupt raised. Mode: %d", interrupt_mode);
+        }
+    }
+
+    template <typename Bus>
+    inline void Core<Bus>::log_instruction(u16 address, u8 opcode) {
+        logdebug("[%04X] %02X %02X %02X %02X", address, opcode, read_byte(pc), read_byte(pc + 1), read_byte(pc + 2));
+        if (Log::verbosity >= LOG_VERBOSITY_TRACE) {
+            u8 flags = f.assemble();
+            logtrace("AF: %02X%02X BC: %04X DE: %04X HL: %04X", a, flags, bc.raw, de.raw, hl.raw);
+            logtrace("SZ5H3PVNC");
+            logtrace("%d%d%d%d%d %d%d%d", flags >> 7, (flags >> 6) & 1, (flags >> 5) & 1, (flags >> 4) & 1,
+                     (flags >> 3) & 1, (flags >> 2) & 1, (flags >> 1) & 1, flags & 1);
+        }
+    }
+
+    template <typename Bus>
+    inline int Core<Bus>::execute_instruction() {
+        interrupts_enabled = next_interrupts_enabled;
+
+        u16 address = pc;
+        u8 opcode = read_byte(pc++);
+
+        log_instruction(address, opcode);
+
+        instructions++;
+
+        u8 r_hi = r & 0x80;
+        r = r_hi | ((r + 1) & 0x7F);
+
+        int cycles = Z80::instructions<Bus>[opcode](*this);
+
+        if (interrupts_enabled && interrupt_pending) {
+            service_interrupt();
+        }
+
+        return cycles;
+    }
+
+    template <typename Bus>
+    int Core<Bus>::step() {
+        // Repeating instructions only run once
+        block_deadline = executed_cycles;
+        idle_run_cycles = 0;
+        forget_idle_loop();
+        return execute_instruction();
+    }
+
+    template <typename Bus>
+    int Core<Bus>::run(int cycles, int idle_cycles) {
+        run_cycles = cycles;
+        executed_cycles = 0;
+        block_deadline = cycles;
+        idle_run_cycles = std::max(cycles, idle_cycles);
+        // Whatever was outside the CPU could have changed since the last run
+        forget_idle_loop();
+        if (mode == Mode::Cached) {
+            return run_cached() - cycles;
+        }
+        if (mode == Mode::Jit) {
+            return run_jit() - cycles;
+        }
+#ifdef Z80_THREADED_DISPATCH
+        return run_threaded() - cycles;
+#else
+        while (executed_cycles < run_cycles) {
+            executed_cycles += execute_instruction();
+            if (block_break) {
+                end_block_break();
+            }
+        }
+        return executed_cycles - cycles;
+#endif
+    }
+
+    template <typename Bus>
+    u8* Core<Bus>::direct_write(u16 address, int length) {
+        forget_idle_loop();
+        if constexpr (has_write_pages) {
+            u8* page = bus.write_page(address);
+            if (page && !code_cache.contains_code(bus, address, length)) {
+                return page + (address & CODE_PAGE_MASK);
+            }
+        }
+        return nullptr;
+    }
+
+    // Everything an idle loop can change, which is everything but the counters
+    inline bool same_idle_state(const CpuState& a, const CpuState& b) {
+        return a.pc == b.pc && a.a == b.a && a.f.assemble() == b.f.assemble() && a.bc.raw == b.bc.raw
+               && a.de.raw == b.de.raw && a.hl.raw == b.hl.raw && a.sp == b.sp && a.ix.raw == b.ix.raw
+               && a.iy.raw == b.iy.raw && a.i == b.i && a.af_ == b.af_ && a.bc_ == b.bc_ && a.de_ == b.de_
+               && a.hl_ == b.hl_ && a.interrupt_mode == b.interrupt_mode && a.interrupt_pending == b.interrupt_pending
+               && a.interrupts_enabled == b.interrupts_enabled && a.next_interrupts_enabled == b.next_interrupts_enabled
+               && a.halted == b.halted;
+    }
+
+    // An iteration of a loop that ends in the state it started in, having only read memory and repeatable ports, does
+    // exactly the same thing again, as long as what it read is the same. Reading a repeatable port can still change
+    // what it returns the first time (acknowledging an interrupt, say), so it takes a second iteration the same as the
+    // first to be sure. After that the loop is stuck until the next event outside the CPU, so the rest of the
+    // iterations before it can be counted up without running them.
+    template <typename Bus>
+    int Core<Bus>::skip_idle_loop(int cycles) {
+        if constexpr (has_idle_loops) {
+            if (idle_loop.matches >= 0 && same_idle_state(*this, idle_loop.state)) {
+                idle_loop.matches++;
+            } else {
+                idle_loop.matches = 0;
+            }
+
+            int now = executed_cycles + cycles;
+            int skipped = 0;
+            if (idle_loop.matches >= 2) {
+                // Unless something's already cut the run short
+                if (block_deadline == run_cycles && idle_run_cycles > run_cycles) {
+                    run_cycles = idle_run_cycles;
+                    block_deadline = idle_run_cycles;
+                }
+                int iteration_cycles = now - idle_loop.cycles;
+                int iteration_instructions = instructions - idle_loop.state.instructions;
+                int repeats = repeats_left(*this, cycles, iteration_cycles);
+                count_repeats(*this, repeats * iteration_instructions);
+                skipped = repeats * iteration_cycles;
+            }
+
+            idle_loop.state = *this;
+            idle_loop.cycles = now + skipped;
+            return skipped;
+        } else {
+            return 0;
+        }
+    }
+
+#ifdef Z80_THREADED_DISPATCH
+#define Z80_OPCODE_ROW(X, hi) \
+        X(0x##hi##0) X(0x##hi##1) X(0x##hi##2) X(0x##hi##3) X(0x##hi##4) X(0x##hi##5) X(0x##hi##6) X(0x##hi##7) \
+        X(0x##hi##8) X(0x##hi##9) X(0x##hi##A) X(0x##hi##B) X(0x##hi##C) X(0x##hi##D) X(0x##hi##E) X(0x##hi##F)
+#define Z80_OPCODES(X) \
+        Z80_OPCODE_ROW(X, 0) Z80_OPCODE_ROW(X, 1) Z80_OPCODE_ROW(X, 2) Z80_OPCODE_ROW(X, 3) \
+        Z80_OPCODE_ROW(X, 4) Z80_OPCODE_ROW(X, 5) Z80_OPCODE_ROW(X, 6) Z80_OPCODE_ROW(X, 7) \
+        Z80_OPCODE_ROW(X, 8) Z80_OPCODE_ROW(X, 9) Z80_OPCODE_ROW(X, A) Z80_OPCODE_ROW(X, B) \
+        Z80_OPCODE_ROW(X, C) Z80_OPCODE_ROW(X, D) Z80_OPCODE_ROW(X, E) Z80_OPCODE_ROW(X, F)
+
+// Same bookkeeping as execute_instruction(), ending in a jump straight to the next opcode's label
+#define Z80_DISPATCH() do { \
+        if (cycles >= run_cycles) { \
+            goto done; \
+        } \
+        interrupts_enabled = next_interrupts_enabled; \
+        address = pc; \
+        opcode = read_byte(pc++); \
+        if (Log::verbosity >= LOG_VERBOSITY_DEBUG) { \
+            log_instruction(address, opcode); \
+        } \
+        instructions++; \
+        r = (r & 0x80) | ((r + 1) & 0x7F); \
+        goto *labels[opcode]; \
+    } while (0)
+
+#define Z80_LABEL_ADDRESS(opcode) &&op_##opcode,
+#define Z80_LABEL(opcode) \
+    op_##opcode: \
+        if constexpr ((opcode) == 0xED || (opcode) == 0xDD || (opcode) == 0xFD || uses_cycle_count(0, opcode)) { \
+            executed_cycles = cycles; \
+        } \
+        cycles += Z80::instructions<Bus>[opcode](*this); \
+        if (block_break) { \
+            end_block_break(); \
+        } \
+        if (interrupts_enabled && interrupt_pending) { \
+            service_interrupt(); \
+        } \
+        Z80_DISPATCH();
+
+    // The interpreter loop with every opcode's handler inlined under its own label. Each one ends with its own copy of
+    // the dispatch, so there's no call and return per instruction, and the branch predictor gets an indirect jump per
+    // opcode to learn what usually follows it.
+    template <typename Bus>
+    int Core<Bus>::run_threaded() {
+        static const void* const labels[0x100] = { Z80_OPCODES(Z80_LABEL_ADDRESS) };
+
+        // Kept in a local so it can live in a register. Handlers only ever touch run_cycles.
+        int cycles = executed_cycles;
+        u16 address;
+        u8 opcode;
+
+        Z80_DISPATCH();
+        Z80_OPCODES(Z80_LABEL)
+
+    done:
+        executed_cycles = cycles;
+        return cycles;
+    }
+
+#undef Z80_LABEL
+#undef Z80_LABEL_ADDRESS
+#undef Z80_DISPATCH
+#undef Z80_OPCODES
+#undef Z80_OPCODE_ROW
+#endif
+
+    // Does the same work per instruction as execute_instruction(), so it stops on exactly the same instruction.
+    template <typename Bus>
+    inline void Core<Bus>::execute_block(const Block<Bus>& block) {
+        // Blocks end at anything that can jump, so only an interrupt or break_block() can leave one early
+        block_break = false;
+        block_deadline = run_cycles;
+        u16 start = pc;
+        for (const DecodedInstruction<Bus>& instr : block.instructions) {
+            interrupts_enabled = next_interrupts_enabled;
+
+            pc = start + instr.end;
+            operands = instr.operands;
+            prev_immediate = instr.displacement;
+
+            instructions++;
+
+            u8 r_hi = r & 0x80;
+            r = r_hi | ((r + 1) & 0x7F);
+
+            executed_cycles += instr.handler(*this);
+
+            if (interrupts_enabled && interrupt_pending) {
+                service_interrupt();
+                break;
+            }
+
+            if (executed_cycles >= block_deadline) {
+                break;
+            }
+        }
+        operands = nullptr;
+    }
+
+    template <typename Bus>
+    int Core<Bus>::run_cached() {
+        if constexpr (has_code_pages) {
+            Block<Bus>* block = code_cache.lookup(bus, pc);
+            while (executed_cycles < run_cycles) {
+                if (!block || block->instructions.empty()) {
+                    end_block_break();
+                    executed_cycles += execute_instruction();
+                    block = code_cache.lookup(bus, pc);
+                    continue;
+                }
+
+                execute_block(*block);
+
+                if (block_break) {
+                    // The block might not exist anymore
+                    code_cache.release_retired();
+                    block = code_cache.lookup(bus, pc);
+                } else {
+                    block = code_cache.next(bus, block, pc);
+                }
+            }
+        }
+        return executed_cycles;
+    }
+
+    template <typename Bus>
+    int Core<Bus>::run_jit() {
+        if constexpr (has_code_pages) {
+            Block<Bus>* block = code_cache.lookup(bus, pc);
+            while (executed_cycles < run_cycles) {
+                if (!block || block->instructions.empty()) {
+                    end_block_break();
+                    executed_cycles += execute_instruction();
+                    block = code_cache.lookup(bus, pc);
+                    continue;
+                }
+
+                // Code that gets rewritten before it runs again (like zexdoc's test instructions) would be translated
+                // over and over, so blocks are only translated once they've been run a few times
+                if (!block->native && ++block->runs >= JIT_THRESHOLD && !jit.compile(*this, *block)) {
+                    // Out of space for code. Start again from scratch.
+                    code_cache.flush();
+                    jit.reset();
+                    block = code_cache.lookup(bus, pc);
+                    continue;
+                }
+
+                if (block->native) {
+                    block_break = false;
+                    block_deadline = run_cycles;
+                    executed_cycles = block->native(this, executed_cycles);
+                    operands = nullptr;
+                } else {
+                    execute_block(*block);
+                }
+
+                if (block_break) {
+                    code_cache.release_retired();
+                    block = code_cache.lookup(bus, pc);
+                } else {
+                    block = code_cache.next(bus, block, pc);
+                }
+            }
+        }
+        return executed_cycles;
+    }
+
+    // Decodes the instruction at code, which has `available` bytes left before the end of its page. Returns false if
+    // it has to be left to the interpreter.
+    template <typename Bus>
+    bool decode_instruction(const u8* code, int available, DecodedInstruction<Bus>& instr, bool& end_of_block) {
+        instr = {};
+        end_of_block = false;
+
+        int opcode_length;
+        int operands = 0;
+        u8 opcode = code[0];
+        switch (opcode) {
+            case 0xCB:
+                if (available < 2) {
+                    return false;
+                }
+                instr.handler = cb_instructions<Bus>[code[1]];
+                instr.prefix = 0xCB;
+                instr.opcode = code[1];
+                opcode_length = 2;
+                break;
+            case 0xED:
+                if (available < 2 || code[1] >= 0xC0) {
+                    return false;
+                }
+                instr.handler = ed_instructions<Bus>[code[1]];
+                instr.prefix = 0xED;
+                instr.opcode = code[1];
+                opcode_length = 2;
+                operands = ed_operand_length(code[1]);
+                end_of_block = ed_ends_block(code[1]);
+                break;
+            case 0xDD:
+            case 0xFD:
+                if (available < 2) {
+                    return false;
+                }
+                if (code[1] == 0xCB) {
+                    if (available < 4) {
+                        return false;
+                    }
+                    instr.handler = opcode == 0xDD ? ddcb_instructions<Bus>[code[3]] : fdcb_instructions<Bus>[code[3]];
+                    instr.prefix = (opcode << 8) | 0xCB;
+                    instr.opcode = code[3];
+                    opcode_length = 4;
+                    instr.displacement = code[2];
+                } else if (code[1] == 0xDD || code[1] == 0xED || code[1] == 0xFD) {
+                    return false;
+                } else {
+                    instr.handler = opcode == 0xDD ? dd_instructions<Bus>[code[1]] : fd_instructions<Bus>[code[1]];
+                    instr.prefix = opcode;
+                    instr.opcode = code[1];
+                    opcode_length = 2;
+                    operands = operand_length(code[1]) + (uses_index_displacement(code[1]) ? 1 : 0);
+                    end_of_block = ends_block(code[1]);
+                }
+                break;
+            default:
+                instr.handler = instructions<Bus>[opcode];
+                instr.opcode = opcode;
+                opcode_length = 1;
+                operands = operand_length(opcode);
+                end_of_block = ends_block(opcode);
+                break;
+        }
+
+        instr.length = opcode_length + operands;
+        if (instr.length > available) {
+            return false;
+        }
+        for (int i = 0; i < operands; i++) {
+            instr.operands[i] = code[opcode_length + i];
+        }
+        return true;
+    }
+
+    template <typename Bus>
+    std::unique_ptr<Block<Bus>> CodeCache<Bus>::decode_block(const u8* host, int offset) {
+        auto block = std::make_unique<Block<Bus>>();
+        int position = offset;
+        while (block->instructions.size() < MAX_BLOCK_INSTRUCTIONS) {
+            DecodedInstruction<Bus> instr;
+            bool end_of_block;
+            if (!decode_instruction(host + position, CODE_PAGE_SIZE - position, instr, end_of_block)) {
+                break;
+            }
+            position += instr.length;
+            instr.end = position - offset;
+            block->instructions.push_back(instr);
+            if (end_of_block) {
+                break;
+            }
+        }
+        block->length = position - offset;
+        return block;
+    }
+
+    template <typename Bus>
+    void CodeCache<Bus>::remap(const u8* host, int index, bool create) {
+        auto it = pages.find(host);
+        mapped_host[index] = host;
+        mapped_page[index] = it == pages.end() ? nullptr : it->second.get();
+
+        if (!mapped_page[index] && create) {
+            auto page = std::make_unique<CodePage<Bus>>();
+            // Other guest pages can map the same memory
+            for (int i = 0; i < NUM_CODE_PAGES; i++) {
+                if (mapped_host[i] == host) {
+                    mapped_page[i] = page.get();
+                }
+            }
+            pages[host] = std::move(page);
+            std::fill(std::begin(write_coverage), std::end(write_coverage), nullptr);
+        }
+    }
+
+    template <typename Bus>
+    const u8* CodeCache<Bus>::find_write_coverage(Bus& bus, u16 address) {
+        int index = address >> CODE_PAGE_SHIFT;
+        const u8* host = bus.code_page(address);
+        CodePage<Bus>* page = host ? find_page(host, address, false) : nullptr;
+        write_page[index] = page;
+        write_coverage[index] = page ? page->coverage : NO_CODE;
+        return write_coverage[index];
+    }
+
+    template <typename Bus>
+    Block<Bus>* CodeCache<Bus>::lookup_slow(const u8* host, u16 address) {
+        retired.clear();
+
+        if (!host) {
+            return nullptr;
+        }
+
+        CodePage<Bus>* page = find_page(host, address, true);
+        int offset = address & CODE_PAGE_MASK;
+        std::unique_ptr<Block<Bus>>& block = page->blocks[offset];
+        if (!block) {
+            block = decode_block(host, offset);
+            for (int i = offset; i < offset + block->length; i++) {
+                page->coverage[i]++;
+            }
+        }
+        return block.get();
+    }
+
+    template <typename Bus>
+    void CodeCache<Bus>::invalidate_blocks(CodePage<Bus>* page, int offset) {
+        int first = std::max(0, offset - MAX_BLOCK_INSTRUCTIONS * MAX_INSTRUCTION_LENGTH + 1);
+        for (int start = first; start <= offset; start++) {
+            std::unique_ptr<Block<Bus>>& block = page->blocks[start];
+            if (block && start + block->length > offset) {
+                for (int i = start; i < start + block->length; i++) {
+                    page->coverage[i]--;
+                }
+                retired.push_back(std::move(block));
+            }
+        }
+        epoch++;
+    }
+
+    template <typename Bus>
+    bool Jit<Bus>::compile(Core<Bus>& cpu, Block<Bus>& block) {
+#if defined(__x86_64__)
+        if (!buffer) {
+            void* memory = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                logfatal("Failed to allocate memory for the JIT");
+            }
+            buffer = static_cast<u8*>(memory);
+        }
+        if (CODE_BUFFER_SIZE - used < MAX_BLOCK_CODE) {
+            return false;
+        }
+
+        u8* start = buffer + used;
+        code = start;
+
+        emit_push(RBX);
+        emit_push(R12);
+        emit_push(R13);
+        emit8(0x48); // mov rbx, rdi
+        emit8(0x89);
+        emit8(0xFB);
+        emit8(0x41); // mov r13d, esi
+        emit8(0x89);
+        emit8(0xF5);
+        emit_load16(R12, offset(cpu, &cpu.pc));
+
+        std::vector<u8*> exits;
+        std::vector<u8*> interrupts;
+        bool after_native = false;
+        for (size_t i = 0; i < block.instructions.size(); i++) {
+            after_native = emit_instruction(cpu, block.instructions[i], i == block.instructions.size() - 1,
+                                            after_native, exits, interrupts);
+        }
+
+        u8* exit = code;
+        emit8(0x44); // mov eax, r13d
+        emit8(0x89);
+        emit8(0xE8);
+        emit_pop(R13);
+        emit_pop(R12);
+        emit_pop(RBX);
+        emit8(0xC3); // ret
+
+        u8* interrupt = code;
+        emit_call(reinterpret_cast<const void*>(&Jit<Bus>::service_interrupt));
+        emit8(0xE9); // jmp exit
+        emit32(0);
+        patch_jump(code - 4, exit);
+
+        for (u8* jump : exits) {
+            patch_jump(jump, exit);
+        }
+        for (u8* jump : interrupts) {
+            patch_jump(jump, interrupt);
+        }
+
+        used += code - start;
+        block.native = reinterpret_cast<int (*)(Core<Bus>*, int)>(start);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#if defined(__x86_64__)
+    template <typename Bus>
+    void Jit<Bus>::service_interrupt(Core<Bus>* cpu) {
+        cpu->service_interrupt();
+    }
+
+    // Translated instructions can't change interrupts_enabled, next_interrupts_enabled or interrupt_pending. So once
+    // one has been checked for an interrupt, the ones straight after it don't need to be: nothing can have changed.
+    template <typename Bus>
+    bool Jit<Bus>::emit_instruction(Core<Bus>& cpu, const DecodedInstruction<Bus>& instr, bool last, bool after_native,
+                                    std::vector<u8*>& exits, std::vector<u8*>& interrupts) {
+        // Same bookkeeping as Core::execute_instruction()
+        emit_block_address(RAX, instr.end);
+        emit_store16(offset(cpu, &cpu.pc), RAX);
+
+        emit_add64_imm(offset(cpu, &cpu.instructions), 1);
+
+        emit_load8(RAX, offset(cpu, &cpu.r));
+        emit8(0x8D); // lea ecx, [rax + 1]
+        emit8(0x48);
+        emit8(0x01);
+        emit8(0x83); // and ecx, 0x7F
+        emit8(0xE1);
+        emit8(0x7F);
+        emit8(0x25); // and eax, 0x80
+        emit32(0x80);
+        emit8(0x09); // or eax, ecx
+        emit8(0xC8);
+        emit_store8(offset(cpu, &cpu.r), RAX);
+
+        int cycles;
+        bool native = emit_native(cpu, instr, cycles);
+        if (!native || !after_native) {
+            // It doesn't matter where this goes for a translated instruction, as it doesn't look at it
+            emit_load8(RAX, offset(cpu, &cpu.next_interrupts_enabled));
+            emit_store8(offset(cpu, &cpu.interrupts_enabled), RAX);
+        }
+        if (native) {
+            emit8(0x41); // add r13d, cycles
+            emit8(0x81);
+            emit8(0xC5);
+            emit32(cycles);
+        } else {
+            emit_mov_imm64(RAX, reinterpret_cast<u64>(instr.operands));
+            emit_store64(offset(cpu, &cpu.operands), RAX);
+            if (instr.prefix == 0xDDCB || instr.prefix == 0xFDCB) {
+                emit_store8_imm(offset(cpu, &cpu.prev_immediate), instr.displacement);
+            }
+            if (uses_cycle_count(instr.prefix, instr.opcode)) {
+                emit8(0x44); // mov executed_cycles, r13d, for Core::cycles_left() and cycles_run()
+                emit8(0x89);
+                emit_cpu_operand(R13, offset(cpu, &cpu.executed_cycles));
+            }
+            emit_call(reinterpret_cast<const void*>(instr.handler));
+            emit8(0x41); // add r13d, eax
+            emit8(0x01);
+            emit8(0xC5);
+        }
+
+        if (!native || !after_native) {
+            emit8(0x8A); // mov al, interrupts_enabled
+            emit_cpu_operand(RAX, offset(cpu, &cpu.interrupts_enabled));
+            emit8(0x22); // and al, interrupt_pending
+            emit_cpu_operand(RAX, offset(cpu, &cpu.interrupt_pending));
+            interrupts.push_back(emit_jump(0x85)); // jnz
+        }
+
+        if (!last) {
+            emit8(0x44); // cmp r13d, block_deadline
+            emit8(0x3B);
+            emit_cpu_operand(R13, offset(cpu, &cpu.block_deadline));
+            exits.push_back(emit_jump(0x8D)); // jge
+        }
+        return native;
+    }
+
+    // Puts FlagRegister::carry() in dst, as 0 or 1. Uses rsi.
+    template <typename Bus>
+    void Jit<Bus>::emit_carry(Core<Bus>& cpu, Reg dst) {
+        emit_load16(dst, offset(cpu, &cpu.f.result));
+        emit_shift_imm(5, dst, 8);
+        emit_alu_imm(4, dst, 1);
+        emit_load8(RSI, offset(cpu, &cpu.f.value));
+        emit_alu_imm(4, RSI, FLAG_C);
+        emit8(0x80); // cmp byte op, FlagOp::None
+        emit_cpu_operand(7, offset(cpu, &cpu.f.op));
+        emit8((u8)FlagOp::None);
+        emit8(0x0F); // cmove dst, esi
+        emit8(0x44);
+        emit8(0xC0 | (dst << 3) | RSI);
+    }
+
+    // The cycle counts here have to match what the handlers return
+    template <typename Bus>
+    bool Jit<Bus>::emit_native(Core<Bus>& cpu, const DecodedInstruction<Bus>& instr, int& cycles) {
+        static_assert(std::endian::native == std::endian::little);
+
+        if (instr.prefix != 0) {
+            return false;
+        }
+
+        // Indexed the same way as the opcodes: B, C, D, E, H, L, (HL), A
+        const int reg8[8] = {
+                offset(cpu, &cpu.bc) + 1, offset(cpu, &cpu.bc),
+                offset(cpu, &cpu.de) + 1, offset(cpu, &cpu.de),
+                offset(cpu, &cpu.hl) + 1, offset(cpu, &cpu.hl),
+                -1, offset(cpu, &cpu.a)
+        };
+        // BC, DE, HL, SP
+        const int reg16[4] = {
+                offset(cpu, &cpu.bc), offset(cpu, &cpu.de), offset(cpu, &cpu.hl), offset(cpu, &cpu.sp)
+        };
+
+        // add, adc, sub, sbc, and, xor, or, cp with a register, and then with n
+        const int alu_register_cycles[8] = {4, 4, 4, 4, 4, 7, 7, 7};
+        const int alu_immediate_cycles[8] = {7, 11, 7, 7, 4, 7, 7, 7};
+
+        u8 opcode = instr.opcode;
+        u16 immediate = instr.operands[0] | (instr.operands[1] << 8);
+        int dst = reg8[(opcode >> 3) & 7];
+        int src = reg8[opcode & 7];
+        int pair = reg16[(opcode >> 4) & 3];
+        int alu = (opcode >> 3) & 7;
+
+        if (opcode == 0x00) { // nop
+            cycles = 4;
+        } else if (opcode >= 0x40 && opcode < 0x80 && dst >= 0 && src >= 0) { // ld r, r
+            emit_load8(RAX, src);
+            emit_store8(dst, RAX);
+            cycles = 4;
+        } else if ((opcode & 0xC7) == 0x06 && dst >= 0) { // ld r, n
+            emit_store8_imm(dst, instr.operands[0]);
+            cycles = 7;
+        } else if ((opcode & 0xCF) == 0x01) { // ld rr, nn
+            emit_store16_imm(pair, immediate);
+            cycles = 16;
+        } else if ((opcode & 0xCF) == 0x03) { // inc rr
+            emit_add16_imm(pair, 1);
+            cycles = 6;
+        } else if ((opcode & 0xCF) == 0x0B) { // dec rr
+            emit_add16_imm(pair, -1);
+            cycles = 6;
+        } else if ((opcode & 0xC6) == 0x04 && dst >= 0) { // inc r, dec r
+            bool inc = (opcode & 1) == 0;
+            // Like FlagRegister::set_inc() and set_dec(), which keep the carry from before
+            emit_carry(cpu, RDX);
+            emit_load8(RAX, dst);
+            emit_alu_imm(0, RAX, inc ? 1 : -1);
+            emit_store8(dst, RAX);
+            emit8(0x0F); // movzx eax, al
+            emit8(0xB6);
+            emit8(0xC0);
+            emit_shift_imm(4, RDX, 8);
+            emit_alu(0x09, RAX, RDX);
+            emit_store16(offset(cpu, &cpu.f.result), RAX);
+            emit_store8_imm(offset(cpu, &cpu.f.op), (u8)(inc ? FlagOp::Inc : FlagOp::Dec));
+            cycles = 4;
+        } else if (((opcode & 0xC0) == 0x80 && src >= 0) || (opcode & 0xC7) == 0xC6) { // alu r, alu n
+            emit_load8(RAX, offset(cpu, &cpu.a));
+            if (opcode & 0x40) {
+                emit_mov_imm32(RCX, instr.operands[0]);
+                cycles = alu_immediate_cycles[alu];
+            } else {
+                emit_load8(RCX, src);
+                cycles = alu_register_cycles[alu];
+            }
+            if (alu >= 4 && alu <= 6) {
+                // Like FlagRegister::set_and() and set_or()
+                emit_alu(alu == 4 ? 0x21 : alu == 5 ? 0x31 : 0x09, RAX, RCX);
+                emit_store8(offset(cpu, &cpu.a), RAX);
+                emit_store16(offset(cpu, &cpu.f.result), RAX);
+                emit_store8_imm(offset(cpu, &cpu.f.op), (u8)(alu == 4 ? FlagOp::And : FlagOp::Or));
+            } else {
+                // Like FlagRegister::set_add(), set_sub() and set_cp(). Bit 8 of the result is the carry or borrow.
+                bool add = alu <= 1;
+                bool with_carry = alu == 1 || alu == 3;
+                if (with_carry) {
+                    emit_carry(cpu, RDX);
+                }
+                emit_store8(offset(cpu, &cpu.f.op1), RAX);
+                emit_store8(offset(cpu, &cpu.f.op2), RCX);
+                emit_alu(add ? 0x01 : 0x29, RAX, RCX);
+                if (with_carry) {
+                    emit_alu(add ? 0x01 : 0x29, RAX, RDX);
+                }
+                emit_store16(offset(cpu, &cpu.f.result), RAX);
+                if (alu != 7) {
+                    emit_store8(offset(cpu, &cpu.a), RAX);
+                }
+                emit_store8_imm(offset(cpu, &cpu.f.op),
+                                (u8)(add ? FlagOp::Add : alu == 7 ? FlagOp::Cp : FlagOp::Sub));
+            }
+        } else if (opcode == 0xEB) { // ex de, hl
+            emit_load16(RAX, offset(cpu, &cpu.de));
+            emit_load16(RCX, offset(cpu, &cpu.hl));
+            emit_store16(offset(cpu, &cpu.de), RCX);
+            emit_store16(offset(cpu, &cpu.hl), RAX);
+            cycles = 4;
+        // Jumps back go through their handlers to look for idle loops
+        } else if (opcode == 0xC3 && !Core<Bus>::has_idle_loops) { // jp nn
+            emit_store16_imm(offset(cpu, &cpu.pc), immediate);
+            cycles = 4;
+        } else if (opcode == 0x18 && ((s8)instr.operands[0] >= 0 || !Core<Bus>::has_idle_loops)) { // jr e
+            emit_block_address(RAX, instr.end + (s8)instr.operands[0]);
+            emit_store16(offset(cpu, &cpu.pc), RAX);
+            cycles = 12;
+        } else {
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    template <typename Bus>
+    void CodeCache<Bus>::flush() {
+        unlink();
+        pages.clear();
+        retired.clear();
+        std::fill(std::begin(mapped_host), std::end(mapped_host), nullptr);
+        std::fill(std::begin(mapped_page), std::end(mapped_page), nullptr);
+    }
+}
+
+#endif //SMS_Z80_CORE_H
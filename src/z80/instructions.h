@@ -1,15 +1,3351 @@
 #ifndef SMS_INSTRUCTIONS_H
 #define SMS_INSTRUCTIONS_H
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "z80.h"
+#include "util/types.h"
+#include "util/log.h"
+#include "util.h"
+
 namespace Z80 {
-    typedef int (*instruction)();
-    extern const instruction instructions[0x100];
-    extern const instruction cb_instructions[0x100];
-    extern const instruction dd_instructions[0x100];
-    extern const instruction ddcb_instructions[0x100];
-    extern const instruction ed_instructions[0xC0];
-    extern const instruction fd_instructions[0x100];
-    extern const instruction fdcb_instructions[0x100];
+    enum class Condition {
+        Always,
+        Z, // Z flag is set
+        NZ, // Z flag is reset
+        C, // C flag is set
+        NC, // C flag is reset
+        M, // S flag is set
+        P, // Set flag is reset
+        PE, // P/V flag is set
+        PO, // P/V flag is reset
+    };
+    enum class AddressingMode {
+        Immediate,
+        Indirect,
+        HL,
+        BC,
+        DE,
+        IX,
+        IXPlus,
+        IXPlusPrevious,
+        IY,
+        IYPlus,
+        IYPlusPrevious
+    };
+
+    template <typename Bus>
+    u16 read_16(Core<Bus>& cpu, u16 address) {
+        u16 lo = cpu.read_byte(address + 0);
+        u16 hi = cpu.read_byte(address + 1);
+        return lo | (hi << 8);
+    }
+
+    template <typename Bus>
+    u16 read_16_pc(Core<Bus>& cpu) {
+        u16 lo = cpu.fetch_byte();
+        u16 hi = cpu.fetch_byte();
+        return lo | (hi << 8);
+    }
+
+    template <Register reg, typename T = typename reg_type<reg>::type, typename Bus>
+    T get_register(Core<Bus>& cpu) {
+        switch (reg) {
+            case Register::A:
+                return cpu.a;
+            case Register::F:
+                return cpu.f.assemble();
+            case Register::AF:
+                return ((u16)cpu.a << 8) | cpu.f.assemble();
+            case Register::AF_:
+                return cpu.af_;
+            case Register::B:
+                return cpu.bc[WideRegister::Hi];
+            case Register::C:
+                return cpu.bc[WideRegister::Lo];
+            case Register::BC:
+                return cpu.bc.raw;
+            case Register::BC_:
+                return cpu.bc_;
+            case Register::D:
+                return cpu.de[WideRegister::Hi];
+            case Register::E:
+                return cpu.de[WideRegister::Lo];
+            case Register::DE:
+                return cpu.de.raw;
+            case Register::DE_:
+                return cpu.de_;
+            case Register::H:
+                return cpu.hl[WideRegister::Hi];
+            case Register::L:
+                return cpu.hl[WideRegister::Lo];
+            case Register::HL:
+                return cpu.hl.raw;
+            case Register::HL_:
+                return cpu.hl_;
+            case Register::SP:
+                return cpu.sp;
+            case Register::IX:
+                return cpu.ix.raw;
+            case Register::IXH:
+                return cpu.ix[WideRegister::Hi];
+            case Register::IXL:
+                return cpu.ix[WideRegister::Lo];
+            case Register::IY:
+                return cpu.iy.raw;
+            case Register::IYH:
+                return cpu.iy[WideRegister::Hi];
+            case Register::IYL:
+                return cpu.iy[WideRegister::Lo];
+            case Register::I:
+                return cpu.i;
+            case Register::R:
+                return cpu.r;
+        }
+    }
+
+    template <Register reg, typename T = typename reg_type<reg>::type, typename Bus>
+    void set_register(Core<Bus>& cpu, T value) {
+        switch (reg) {
+            case Register::A:
+                cpu.a = value;
+                break;
+            case Register::F:
+                cpu.f.set(value);
+                break;
+            case Register::AF:
+                cpu.a = value >> 8;
+                cpu.f.set(value & 0xFF);
+                break;
+            case Register::AF_:
+                cpu.af_ = value;
+                break;
+            case Register::B:
+                cpu.bc(WideRegister::Hi) = value;
+                break;
+            case Register::C:
+                cpu.bc(WideRegister::Lo) = value;
+                break;
+            case Register::BC:
+                cpu.bc.raw = value;
+                break;
+            case Register::BC_:
+                cpu.bc_ = value;
+                break;
+            case Register::D:
+                cpu.de(WideRegister::Hi) = value;
+                break;
+            case Register::E:
+                cpu.de(WideRegister::Lo) = value;
+                break;
+            case Register::DE:
+                cpu.de.raw = value;
+                break;
+            case Register::DE_:
+                cpu.de_ = value;
+                break;
+            case Register::H:
+                cpu.hl(WideRegister::Hi) = value;
+                break;
+            case Register::L:
+                cpu.hl(WideRegister::Lo) = value;
+                break;
+            case Register::HL:
+                cpu.hl.raw = value;
+                break;
+            case Register::HL_:
+                cpu.hl_ = value;
+                break;
+            case Register::SP:
+                cpu.sp = value;
+                break;
+            case Register::IX:
+                cpu.ix = value;
+                break;
+            case Register::IXH:
+                cpu.ix(WideRegister::Hi) = value;
+                break;
+            case Register::IXL:
+                cpu.ix(WideRegister::Lo) = value;
+                break;
+            case Register::IY:
+                cpu.iy = value;
+                break;
+            case Register::IYH:
+                cpu.iy(WideRegister::Hi) = value;
+                break;
+            case Register::IYL:
+                cpu.iy(WideRegister::Lo) = value;
+                break;
+            case Register::I:
+                cpu.i = value;
+                break;
+            case Register::R:
+                cpu.r = value;
+                break;
+        }
+    }
+
+    template <Register a, Register b, typename aT = typename reg_type<a>::type, typename bT = typename reg_type<b>::type, typename Bus>
+    void swap_registers(Core<Bus>& cpu) {
+        static_assert(sizeof(aT) == sizeof(bT), "Types of swapped registers must be the same.");
+        aT temp = get_register<a>(cpu);
+        set_register<a>(cpu, get_register<b>(cpu));
+        set_register<b>(cpu, temp);
+    }
+
+    template <Condition c, typename Bus>
+    bool check_condition(Core<Bus>& cpu) {
+        switch (c) {
+            case Condition::Always:
+                return true;
+            case Condition::Z:
+                return cpu.f.zero();
+            case Condition::NZ:
+                return !cpu.f.zero();
+            case Condition::C:
+                return cpu.f.carry();
+            case Condition::NC:
+                return !cpu.f.carry();
+            case Condition::M:
+                return cpu.f.sign();
+            case Condition::P:
+                return !cpu.f.sign();
+            case Condition::PE:
+                return cpu.f.assemble() & FLAG_PV;
+            case Condition::PO:
+                return !(cpu.f.assemble() & FLAG_PV);
+        }
+    }
+
+    template <AddressingMode addressingMode, typename Bus>
+    u16 get_address(Core<Bus>& cpu) {
+        switch (addressingMode) {
+            case AddressingMode::Immediate:
+                logfatal("get_address(cpu) should not be used with the immediate addressing mode!");
+            case AddressingMode::Indirect:
+                return read_16_pc(cpu);
+            case AddressingMode::HL:
+                return cpu.hl.raw;
+            case AddressingMode::BC:
+                return cpu.bc.raw;
+            case AddressingMode::DE:
+                return cpu.de.raw;
+            case AddressingMode::IX:
+                return cpu.ix.raw;
+            case AddressingMode::IY:
+                return cpu.iy.raw;
+            case AddressingMode::IXPlus:
+                return get_register<Register::IX>(cpu) + (s8)cpu.fetch_byte();
+            case AddressingMode::IXPlusPrevious:
+                return get_register<Register::IX>(cpu) + cpu.prev_immediate;
+            case AddressingMode::IYPlus:
+                return get_register<Register::IY>(cpu) + (s8)cpu.fetch_byte();
+            case AddressingMode::IYPlusPrevious:
+                return get_register<Register::IY>(cpu) + cpu.prev_immediate;
+        }
+    }
+
+    template <AddressingMode addressingMode, typename T, typename Bus>
+    T read_value(Core<Bus>& cpu) {
+        if (addressingMode == AddressingMode::Immediate) {
+            switch (sizeof(T)) {
+                case sizeof(u16): {
+                    return read_16_pc(cpu);
+                }
+                case sizeof(u8):
+                    return cpu.fetch_byte();
+            }
+        } else {
+            u16 address = get_address<addressingMode>(cpu);
+            if constexpr(std::is_same_v<T, u16>) {
+                return read_16(cpu, address);
+            } else if constexpr(std::is_same_v<T, u8>) {
+                return cpu.read_byte(address);
+            }
+        }
+    }
+
+    template <AddressingMode addressingMode, typename T, typename Bus>
+    void write_value(Core<Bus>& cpu, T value) {
+        static_assert(std::is_same_v<T, u8>, "only supported for u8");
+        cpu.write_byte(get_address<addressingMode>(cpu), value);
+    }
+
+    constexpr bool vflag_16(u16 a, u16 b, u16 r) {
+        return ((a & 0x8000) == (b & 0x8000)) && ((a & 0x8000) != (r & 0x8000));
+    }
+
+    constexpr bool carry(int bit, u16 a, u16 b, bool c) {
+        u32 result = a + b + c;
+        u32 carry = result ^ a ^ b;
+        return carry & (1 << bit);
+    }
+    template <u8 opc, typename Bus>
+    int unimplemented_instr(Core<Bus>& cpu) {
+        printf("Unimplemented instruction %02X!\n", opc);
+        exit(1);
+    }
+
+    template <u8 opc, typename Bus>
+    int unimplemented_ed_instr(Core<Bus>& cpu) {
+        printf("Unimplemented ED instruction %02X!\n", opc);
+        exit(1);
+    }
+
+    template <u8 opc, typename Bus>
+    int unimplemented_dd_instr(Core<Bus>& cpu) {
+        printf("Unimplemented DD instruction %02X!\n", opc);
+        exit(1);
+    }
+
+    template <u8 opc, typename Bus>
+    int unimplemented_fd_instr(Core<Bus>& cpu) {
+        printf("Unimplemented FD instruction %02X!\n", opc);
+        exit(1);
+    }
+
+    template <Condition c, AddressingMode addressingMode, typename Bus>
+    int instr_jp(Core<Bus>& cpu) {
+        u16 address = get_address<addressingMode>(cpu);
+
+        if (check_condition<c>(cpu)) {
+            bool back = address < cpu.pc;
+            cpu.pc = address;
+            logtrace("Jumped to %04X", cpu.pc);
+            if (addressingMode == AddressingMode::Indirect && back) {
+                return 4 + cpu.skip_idle_loop(4);
+            }
+        }
+
+        if (addressingMode == AddressingMode::Immediate) {
+            return 10;
+        } else {
+            return 4;
+        }
+    }
+
+    template <Condition c, typename Bus>
+    int instr_jr(Core<Bus>& cpu) {
+        s8 offset = cpu.fetch_byte();
+        if (check_condition<c>(cpu)) {
+            cpu.pc += offset;
+            if (offset < 0) {
+                return 12 + cpu.skip_idle_loop(12);
+            }
+            return 12;
+        }
+        return 7;
+    }
+
+    template <Register reg, typename T = typename reg_type<reg>::type, typename Bus>
+    int instr_dec(Core<Bus>& cpu) {
+        switch (sizeof(T)) {
+            case sizeof(u8): {
+                u8 m = get_register<reg>(cpu);
+                u8 r = m - 1;
+                set_register<reg>(cpu, r);
+
+                cpu.f.set_dec(m);
+
+                return 4;
+            }
+            case sizeof(u16): {
+                u16 m = get_register<reg>(cpu);
+                u16 r = m - 1;
+                set_register<reg>(cpu, r);
+                return 6;
+            }
+        }
+    }
+
+    template <AddressingMode src, typename Bus>
+    int instr_dec(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 m = cpu.read_byte(address);
+        u8 r = m - 1;
+        cpu.write_byte(address, r);
+
+        cpu.f.set_dec(m);
+
+        return 4;
+    }
+
+    template <Register reg, typename T = typename reg_type<reg>::type, typename Bus>
+    int instr_inc(Core<Bus>& cpu) {
+        switch (sizeof(T)) {
+            case sizeof(u16): {
+                u16 m = get_register<reg>(cpu);
+                u16 r = m + 1;
+                set_register<reg>(cpu, r);
+                return 6;
+            }
+            case sizeof(u8): {
+                u8 m = get_register<reg>(cpu);
+                u8 r = m + 1;
+                cpu.f.set_inc(m);
+                set_register<reg>(cpu, r);
+                return 4;
+            }
+        }
+    }
+
+    template <AddressingMode src, typename Bus>
+    int instr_inc(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 m = cpu.read_byte(address);
+        u8 r = m + 1;
+        cpu.f.set_inc(m);
+        cpu.write_byte(address, r);
+        return 11;
+    }
+
+
+    template <Register dst, Register src, typename Bus>
+    int instr_ld(Core<Bus>& cpu) {
+        set_register<dst>(cpu, get_register<src>(cpu));
+        return 4;
+    }
+
+
+    template <Register dst, AddressingMode src, typename dstT = typename reg_type<dst>::type, typename Bus>
+    int instr_ld(Core<Bus>& cpu) {
+        set_register<dst>(cpu, read_value<src, dstT>(cpu));
+        if (sizeof(dstT) == sizeof(u16)) {
+            return 16;
+        } else {
+            return 7;
+        }
+    }
+
+    template <AddressingMode dst, Register src, typename srcT = typename reg_type<src>::type, typename Bus>
+    int instr_ld(Core<Bus>& cpu) {
+        u16 address = get_address<dst>(cpu);
+
+        if (sizeof(srcT) == sizeof(u16)) {
+            u16 value = get_register<src>(cpu);
+            cpu.write_byte(address + 0, value & 0xFF);
+            cpu.write_byte(address + 1, (value >> 8) & 0xFF);
+            return 16;
+        } else {
+            cpu.write_byte(address, get_register<src>(cpu));
+            return 13;
+        }
+    }
+
+    template <AddressingMode dst, AddressingMode src, typename Bus>
+    int instr_ld(Core<Bus>& cpu) {
+        u16 dst_addr = get_address<dst>(cpu); // Need to get the dst address first, to handle cases like ld (ix+*),*
+        u8 val = read_value<src, u8>(cpu);
+        cpu.write_byte(dst_addr, val);
+
+        return 10;
+    }
+
+    template <Condition c, typename Bus>
+    int instr_call(Core<Bus>& cpu) {
+        // Read the address first so the return address is correct
+        u16 address = get_address<AddressingMode::Indirect>(cpu);
+
+        if (check_condition<c>(cpu)) {
+            // Push return address
+            stack_push<u16>(cpu, cpu.pc);
+            logtrace("Calling function at %04X - return address is %04X", address, cpu.pc);
+            cpu.pc = address;
+            return 17;
+        }
+        return 10;
+    }
+
+    template <Condition c, typename Bus>
+    int instr_ret(Core<Bus>& cpu) {
+        if (check_condition<c>(cpu)) {
+            // Push return address
+            cpu.pc = stack_pop<u16>(cpu);
+            logtrace("Returning to address %04X", cpu.pc);
+            if (c == Condition::Always) {
+                return 10;
+            } else {
+                return 11;
+            }
+        }
+        return 5;
+    }
+
+    template <Register reg, typename T = typename reg_type<reg>::type, typename Bus>
+    int instr_push(Core<Bus>& cpu) {
+        stack_push<T>(cpu, get_register<reg>(cpu));
+        return 11;
+    }
+
+    template <Register reg, typename T = typename reg_type<reg>::type, typename Bus>
+    int instr_pop(Core<Bus>& cpu) {
+        set_register<reg>(cpu, stack_pop<T>(cpu));
+        return 10;
+    }
+
+    template <AddressingMode addressingMode, typename Bus>
+    int instr_or(Core<Bus>& cpu) {
+        cpu.a = cpu.a | read_value<addressingMode, u8>(cpu);
+        cpu.f.set_or(cpu.a);
+        return 7;
+    }
+
+    template <Register src, typename Bus>
+    int instr_or(Core<Bus>& cpu) {
+        cpu.a = cpu.a | get_register<src>(cpu);
+        cpu.f.set_or(cpu.a);
+        return 7;
+    }
+
+    template <AddressingMode addressingMode, typename Bus>
+    int instr_xor(Core<Bus>& cpu) {
+        cpu.a = cpu.a ^ read_value<addressingMode, u8>(cpu);
+        cpu.f.set_or(cpu.a);
+        return 7;
+    }
+
+    template <Register src, typename Bus>
+    int instr_xor(Core<Bus>& cpu) {
+        cpu.a = cpu.a ^ get_register<src>(cpu);
+        cpu.f.set_or(cpu.a);
+        return 7;
+    }
+
+    template <Register dst, Register src, typename Bus>
+    int instr_add(Core<Bus>& cpu) {
+        static_assert(get_register_size<src>() == get_register_size<dst>(), "src and dst must be the same type");
+        if (get_register_size<dst>() == sizeof(u8)) {
+            u16 op1 = get_register<dst>(cpu);
+            u16 op2 = get_register<src>(cpu);
+            u16 res = op1 + op2;
+            set_register<dst>(cpu, res & 0xFF);
+
+            cpu.f.set_add(op1, op2, false);
+            return 4;
+        } else if (get_register_size<dst>() == sizeof(u16)) {
+            u32 op1 = get_register<dst>(cpu);
+            u32 op2 = get_register<src>(cpu);
+            u32 res = op1 + op2;
+            set_register<dst>(cpu, res & 0xFFFF);
+
+            cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV))
+                      | ((res >> 8) & (FLAG_B5 | FLAG_B3))
+                      | (carry(12, op1, op2, false) ? FLAG_H : 0)
+                      | (carry(16, op1, op2, false) ? FLAG_C : 0));
+            return 11;
+        }
+        logfatal("Should not reach here");
+    }
+
+    template <Register dst, AddressingMode src, typename Bus>
+    int instr_add(Core<Bus>& cpu) {
+        static_assert(get_register_size<dst>() == sizeof(u8));
+        u16 op1 = get_register<dst>(cpu);
+        u16 op2 = read_value<src, u8>(cpu);
+        u16 res = op1 + op2;
+        set_register<dst>(cpu, res & 0xFF);
+
+        cpu.f.set_add(op1, op2, false);
+        return 7;
+    }
+
+    template <Register dst, Register src, typename Bus>
+    int instr_adc(Core<Bus>& cpu) {
+        static_assert(get_register_size<src>() == get_register_size<dst>(), "src and dst must be the same type");
+        if (get_register_size<dst>() == sizeof(u8)) {
+            u16 op1 = get_register<dst>(cpu);
+            u16 op2 = get_register<src>(cpu);
+            bool carry = cpu.f.carry();
+            u16 res = op1 + op2 + carry;
+            set_register<dst>(cpu, res & 0xFF);
+
+            cpu.f.set_add(op1, op2, carry);
+            return 4;
+        } else if (get_register_size<dst>() == sizeof(u16)) {
+            u32 op1 = get_register<dst>(cpu);
+            u32 op2 = get_register<src>(cpu);
+            bool carry_in = cpu.f.carry();
+            u32 res = op1 + op2 + carry_in;
+            set_register<dst>(cpu, res & 0xFFFF);
+
+            cpu.f.set(((res >> 8) & (FLAG_S | FLAG_B5 | FLAG_B3))
+                      | (res == 0 ? FLAG_Z : 0)
+                      | (vflag_16(op1, op2, res) ? FLAG_PV : 0)
+                      | (carry(12, op1, op2, carry_in) ? FLAG_H : 0)
+                      | (carry(16, op1, op2, carry_in) ? FLAG_C : 0));
+            return 11;
+        }
+        logfatal("Should not reach here");
+    }
+
+    template <Register dst, AddressingMode src, typename Bus>
+    int instr_adc(Core<Bus>& cpu) {
+        static_assert(get_register_size<dst>() == sizeof(u8));
+        u16 op1 = get_register<dst>(cpu);
+        u16 op2 = read_value<src, u8>(cpu);
+        bool carry = cpu.f.carry();
+        u16 res = op1 + op2 + carry;
+        set_register<dst>(cpu, res & 0xFF);
+
+        cpu.f.set_add(op1, op2, carry);
+        return 11;
+    }
+
+    template <Register src, typename Bus>
+    int instr_sub(Core<Bus>& cpu) {
+        u16 op1 = cpu.a;
+        // this is subtraction, convert to negative and add
+        u8 value = get_register<src>(cpu);
+        u16 op2 = (u8)((~value) + 1);
+        u16 res = op1 + op2;
+        cpu.a = res & 0xFF;
+
+        cpu.f.set_sub(op1, value, false);
+        return 4;
+    }
+
+    template <AddressingMode src, typename Bus>
+    int instr_sub(Core<Bus>& cpu) {
+        u16 op1 = cpu.a;
+        // this is subtraction, convert to negative and add
+        u8 value = read_value<src, u8>(cpu);
+        u16 op2 = (u8)((~value) + 1);
+        u16 res = op1 + op2;
+        cpu.a = res & 0xFF;
+
+        cpu.f.set_sub(op1, value, false);
+        return 7;
+    }
+
+    template <typename Bus>
+    int instr_neg(Core<Bus>& cpu) {
+        // "neg is the same as subtracting a from 0"
+        u16 op1 = 0;
+        // this is subtraction, convert to negative and add
+        u8 value = cpu.a;
+        u16 op2 = (u8)((~value) + 1);
+        u16 res = op1 + op2;
+        cpu.a = res & 0xFF;
+
+        cpu.f.set_sub(op1, value, false);
+        return 7;
+    }
+
+    template <Register dst, Register src, typename dstT = typename reg_type<dst>::type, typename srcT = typename reg_type<src>::type, typename Bus>
+    int instr_sbc(Core<Bus>& cpu) {
+        static_assert(std::is_same_v<dstT, srcT>, "SBC only valid when dst and src are the same size");
+
+        if (std::is_same_v<dstT, u16>) {
+            u16 minuend = get_register<dst>(cpu);
+            u32 subtrahend = get_register<src>(cpu) + cpu.f.carry();
+            u16 result = minuend - subtrahend;
+            set_register<dst>(cpu, result);
+            cpu.f.set(((result >> 8) & (FLAG_S | FLAG_B5 | FLAG_B3))
+                      | (result == 0 ? FLAG_Z : 0)
+                      | (vflag_16(minuend, ~subtrahend + 1, result) ? FLAG_PV : 0)
+                      | ((minuend & 0xFFF) < (subtrahend & 0xFFF) ? FLAG_H : 0)
+                      | FLAG_N
+                      | (subtrahend > minuend ? FLAG_C : 0));
+
+            return 15;
+        } else if (std::is_same_v<dstT, u8>) {
+            u8 minuend = get_register<dst>(cpu);
+            u8 value = get_register<src>(cpu);
+            int carry = cpu.f.carry();
+            u16 subtrahend = value + carry;
+            u8 result = minuend - subtrahend;
+            set_register<dst>(cpu, result);
+            cpu.f.set_sub(minuend, value, carry);
+            return 4;
+        }
+    }
+
+    template <Register dst, AddressingMode src, typename dstT = typename reg_type<dst>::type, typename Bus>
+    int instr_sbc(Core<Bus>& cpu) {
+        static_assert(std::is_same_v<dstT, u8>, "sbc mem only valid for 8 bit registers");
+
+        int carry = cpu.f.carry();
+
+        u8 minuend = get_register<dst>(cpu);
+        u8 value = read_value<src, u8>(cpu);
+        u16 subtrahend = value + carry;
+        u8 result = minuend - subtrahend;
+        set_register<dst>(cpu, result);
+        cpu.f.set_sub(minuend, value, carry);
+
+        return 7;
+    }
+
+    template <Register src, typename T = typename reg_type<src>::type, typename Bus>
+    int instr_and(Core<Bus>& cpu) {
+        static_assert(std::is_same_v<T, u8>, "Only defined for 8 bit regs");
+        cpu.a = cpu.a & get_register<src>(cpu);
+        cpu.f.set_and(cpu.a);
+        return 4;
+    }
+
+    template <AddressingMode src, typename Bus>
+    int instr_and(Core<Bus>& cpu) {
+        cpu.a = cpu.a & read_value<src, u8>(cpu);
+        cpu.f.set_and(cpu.a);
+        return 4;
+    }
+
+    template <AddressingMode addressingMode, typename Bus>
+    int instr_cp(Core<Bus>& cpu) {
+        u8 s = read_value<addressingMode, u8>(cpu);
+        cpu.f.set_cp(cpu.a, s);
+
+        return 7;
+    }
+
+    template <Register src, typename Bus>
+    int instr_cp(Core<Bus>& cpu) {
+        u8 s = get_register<src>(cpu);
+        cpu.f.set_cp(cpu.a, s);
+
+        return 7;
+    }
+
+    template <typename Bus>
+    int instr_ex_af(Core<Bus>& cpu) {
+        swap_registers<Register::AF, Register::AF_>(cpu);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_exx(Core<Bus>& cpu) {
+        swap_registers<Register::BC, Register::BC_>(cpu);
+        swap_registers<Register::DE, Register::DE_>(cpu);
+        swap_registers<Register::HL, Register::HL_>(cpu);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_ex_de_hl(Core<Bus>& cpu) {
+        swap_registers<Register::DE, Register::HL>(cpu);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_in(Core<Bus>& cpu) {
+        cpu.a = cpu.port_in(cpu.fetch_byte());
+        return 4;
+    }
+
+    // Repeating instructions move pc back to themselves after each iteration, which would send every iteration back
+    // through the dispatch loop. Instead they carry on in the handler for as long as the dispatch loop would have kept
+    // running them, so they stop on the same iteration with the same state.
+
+    // Does the dispatch loop's bookkeeping for `count` more iterations
+    template <typename Bus>
+    void count_repeats(Core<Bus>& cpu, int count) {
+        cpu.instructions += count;
+        cpu.r = (cpu.r & 0x80) | ((cpu.r + count) & 0x7F);
+    }
+
+    // Returns true if the dispatch loop would run another iteration after ones taking `cycles`, and does its
+    // bookkeeping for it
+    template <typename Bus>
+    bool repeat_instruction(Core<Bus>& cpu, int cycles) {
+        if ((cpu.interrupts_enabled && cpu.interrupt_pending) || cycles >= cpu.cycles_left()) {
+            return false;
+        }
+        cpu.interrupts_enabled = cpu.next_interrupts_enabled;
+        count_repeats(cpu, 1);
+        return true;
+    }
+
+    // How many more iterations taking `iteration_cycles` the dispatch loop would run after the current one, which
+    // started `cycles` into the instruction, if nothing else stops it first
+    template <typename Bus>
+    int repeats_left(Core<Bus>& cpu, int cycles, int iteration_cycles) {
+        if (cpu.interrupts_enabled != cpu.next_interrupts_enabled
+            || (cpu.interrupts_enabled && cpu.interrupt_pending)) {
+            return 0;
+        }
+        int left = cpu.cycles_left() - cycles;
+        return left > 0 ? (left - 1) / iteration_cycles : 0;
+    }
+
+    // The interpreter fetches a repeating instruction again for every iteration, so it sees it if it's overwritten
+    template <typename Bus>
+    bool instruction_changed(Core<Bus>& cpu, u8 opcode) {
+        return cpu.read_byte(cpu.pc - 2) != 0xED || cpu.read_byte(cpu.pc - 1) != opcode;
+    }
+
+    template<int hl_increment, typename Bus>
+    inline int instr_cpd_cpi(Core<Bus>& cpu) {
+        u8 s = read_value<AddressingMode::HL, u8>(cpu);
+        u8 r = cpu.a - s;
+
+        bool h = (s & 0xF) > (cpu.a & 0xF); // overflow on lower half of reg
+        u8 n = r - h;
+
+        cpu.hl.raw += hl_increment;
+        cpu.bc.raw--;
+
+        cpu.f.set((cpu.f.assemble() & FLAG_C)
+                  | (flag_tables.sz53[r] & (FLAG_S | FLAG_Z))
+                  | (h ? FLAG_H : 0)
+                  | (n & FLAG_B3)
+                  | ((n << 4) & FLAG_B5)
+                  | (cpu.bc.raw != 0 ? FLAG_PV : 0)
+                  | FLAG_N);
+
+        return 16;
+    }
+
+    // Skips over up to count bytes for cpir / cpdr that don't match A, searching host memory directly. Returns how many
+    // it skipped.
+    template<int hl_increment, typename Bus>
+    int skip_direct(Core<Bus>& cpu, int count) {
+        if constexpr (Core<Bus>::has_write_pages) {
+            u16 address = cpu.hl.raw;
+            const u8* page = cpu.bus.code_page(address);
+            if (count <= 0 || !page) {
+                return 0;
+            }
+            const u8* start = page + (address & CODE_PAGE_MASK);
+            int skipped = 0;
+            if constexpr (hl_increment > 0) {
+                count = std::min(count, CODE_PAGE_SIZE - (address & CODE_PAGE_MASK));
+                const u8* match = static_cast<const u8*>(memchr(start, cpu.a, count));
+                skipped = match ? match - start : count;
+            } else {
+                count = std::min(count, (address & CODE_PAGE_MASK) + 1);
+                while (skipped < count && start[-skipped] != cpu.a) {
+                    skipped++;
+                }
+            }
+            cpu.hl.raw += hl_increment * skipped;
+            cpu.bc.raw -= skipped;
+            return skipped;
+        }
+        return 0;
+    }
+
+    template<int hl_increment, typename Bus>
+    int instr_cpdr_cpir(Core<Bus>& cpu) {
+        int cycles = 0;
+        while (true) {
+            // Iterations that don't find a match can be skipped in one go, leaving the last one to set the flags
+            int repeats = std::min(repeats_left(cpu, cycles, 21), (cpu.bc.raw - 1) & 0xFFFF);
+            int skipped = skip_direct<hl_increment>(cpu, repeats);
+            count_repeats(cpu, skipped);
+            cycles += 21 * skipped + instr_cpd_cpi<hl_increment>(cpu);
+
+            if (get_register<Register::BC>(cpu) == 0 || cpu.f.zero()) {
+                return cycles;
+            }
+            cycles += 5;
+            if (!repeat_instruction(cpu, cycles)) {
+                cpu.pc -= 2;
+                return cycles;
+            }
+        }
+    }
+
+    template <AddressingMode port, Register value, typename Bus>
+    int instr_out(Core<Bus>& cpu) {
+        cpu.port_out(read_value<port, u8>(cpu), get_register<value>(cpu));
+        return 4;
+    }
+
+    template <Register port, Register value, typename Bus>
+    int instr_out(Core<Bus>& cpu) {
+        cpu.port_out(get_register<port>(cpu), get_register<value>(cpu));
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_outi(Core<Bus>& cpu) {
+        u8 b = read_value<AddressingMode::HL, u8>(cpu);
+        u8 port = get_register<Register::C>(cpu);
+        cpu.port_out(port, b);
+
+        cpu.hl.raw++;
+        u8 reg_b = get_register<Register::B>(cpu) - 1;
+        set_register<Register::B>(cpu, reg_b);
+
+        return 16;
+    }
+
+    template <typename Bus>
+    int instr_otir(Core<Bus>& cpu) {
+        int cycles = 0;
+        while (true) {
+            cpu.iteration_cycles = cycles;
+            cycles += instr_outi(cpu);
+
+            if (get_register<Register::B>(cpu) == 0) {
+                break;
+            }
+            cycles += 5;
+            // The write can raise an interrupt or end the run, which repeat_instruction() checks for
+            if (!repeat_instruction(cpu, cycles)) {
+                cpu.pc -= 2; // repeat
+                break;
+            }
+        }
+        cpu.iteration_cycles = 0;
+        return cycles;
+    }
+
+    template <typename Bus>
+    int instr_nop(Core<Bus>& cpu) {
+        return 4;
+    }
+
+    // Executes nops until an interrupt, by going back to the halt each time like the repeating instructions. They all
+    // get done here, up to the end of the run.
+    template <typename Bus>
+    int instr_halt(Core<Bus>& cpu) {
+        cpu.halted = true;
+        cpu.pc--;
+        int repeats = repeats_left(cpu, 0, 4);
+        count_repeats(cpu, repeats);
+        return 4 + 4 * repeats;
+    }
+
+    template <typename Bus>
+    void set_ld_flags(Core<Bus>& cpu, u8 value) {
+        u8 r = value + cpu.a;
+
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_C))
+                  | (cpu.bc.raw > 0 ? FLAG_PV : 0)
+                  | (r & FLAG_B3)
+                  | ((r << 4) & FLAG_B5));
+    }
+
+    template <typename Bus>
+    int instr_ldi(Core<Bus>& cpu) {
+        u8 value = cpu.read_byte(cpu.hl.raw);
+        cpu.write_byte(cpu.de.raw, value);
+        cpu.hl.raw++;
+        cpu.de.raw++;
+        cpu.bc.raw--;
+
+        set_ld_flags(cpu, value);
+        return 16;
+    }
+
+
+    template <typename Bus>
+    int instr_ldd(Core<Bus>& cpu) {
+        u8 value = cpu.read_byte(cpu.hl.raw);
+        cpu.write_byte(cpu.de.raw, value);
+        cpu.hl.raw--;
+        cpu.de.raw--;
+        cpu.bc.raw--;
+
+        set_ld_flags(cpu, value);
+        return 16;
+    }
+
+    // How far b is past a, wrapping around if it's before it. They can be in different arrays.
+    inline uintptr_t host_distance(const u8* a, const u8* b) {
+        return reinterpret_cast<uintptr_t>(b) - reinterpret_cast<uintptr_t>(a);
+    }
+
+    // Copies up to count bytes for ldir / lddr straight between host memory. Returns how many it copied, which is 0 if
+    // the memory isn't mapped directly or the copy could overwrite code.
+    template <int increment, typename Bus>
+    int copy_direct(Core<Bus>& cpu, int count, u8& last) {
+        if constexpr (Core<Bus>::has_write_pages) {
+            u16 src = cpu.hl.raw;
+            u16 dst = cpu.de.raw;
+            // Both sides have to stay within a page
+            if constexpr (increment > 0) {
+                count = std::min({count, CODE_PAGE_SIZE - (src & CODE_PAGE_MASK),
+                                  CODE_PAGE_SIZE - (dst & CODE_PAGE_MASK)});
+            } else {
+                count = std::min({count, (src & CODE_PAGE_MASK) + 1, (dst & CODE_PAGE_MASK) + 1});
+            }
+            // The lowest address of each
+            u16 src_start = increment > 0 ? src : src - (count - 1);
+            u16 dst_start = increment > 0 ? dst : dst - (count - 1);
+
+            const u8* src_page = cpu.bus.code_page(src);
+            u8* to = cpu.direct_write(dst_start, count);
+            if (!src_page || !to) {
+                return 0;
+            }
+            const u8* from = src_page + (src_start & CODE_PAGE_MASK);
+
+            // The instruction itself isn't covered by a cached block in the interpreter
+            for (u16 address : { (u16)(cpu.pc - 2), (u16)(cpu.pc - 1) }) {
+                const u8* page = cpu.bus.code_page(address);
+                if (!page || host_distance(to, page + (address & CODE_PAGE_MASK)) < (uintptr_t)count) {
+                    return 0;
+                }
+            }
+
+            // Going a byte at a time repeats the start of the source when the destination overlaps it in the direction
+            // of the copy, which is how RAM is usually cleared
+            std::ptrdiff_t distance = increment * (std::ptrdiff_t)host_distance(from, to);
+            if (distance <= 0 || distance >= count) {
+                memmove(to, from, count);
+            } else if constexpr (increment > 0) {
+                // A pattern `distance` bytes long, which can be doubled up with memcpy
+                memcpy(to, from, distance);
+                for (int done = distance; done < count; done += std::min(done, count - done)) {
+                    memcpy(to + done, to, std::min(done, count - done));
+                }
+            } else {
+                for (int i = count - 1; i >= 0; i--) {
+                    to[i] = from[i];
+                }
+            }
+
+            last = to[increment > 0 ? count - 1 : 0];
+            cpu.hl.raw += increment * count;
+            cpu.de.raw += increment * count;
+            cpu.bc.raw -= count;
+            return count;
+        }
+        return 0;
+    }
+
+    template <int increment, typename Bus>
+    int instr_lddr_ldir(Core<Bus>& cpu) {
+        constexpr u8 opcode = increment > 0 ? 0xB0 : 0xB8;
+        int cycles = 0;
+        u8 value;
+        bool changed = false;
+        do {
+            // This iteration, along with as many of the following ones as can be copied in one go
+            int count = 0;
+            int repeats = std::min(repeats_left(cpu, cycles, 21), (cpu.bc.raw - 1) & 0xFFFF);
+            if (repeats > 0 && (count = copy_direct<increment>(cpu, repeats + 1, value))) {
+                count_repeats(cpu, count - 1);
+            } else {
+                value = cpu.read_byte(cpu.hl.raw);
+                cpu.write_byte(cpu.de.raw, value);
+                cpu.hl.raw += increment;
+                cpu.de.raw += increment;
+                cpu.bc.raw--;
+                count = 1;
+                changed = instruction_changed(cpu, opcode);
+            }
+            cycles += 21 * count;
+        } while (cpu.bc.raw && !changed && repeat_instruction(cpu, cycles));
+
+        set_ld_flags(cpu, value);
+        if (cpu.bc.raw) {
+            cpu.pc -= 2; // Repeat the instruction until BC is zero
+            return cycles;
+        }
+        return cycles - 5;
+    }
+
+    template <typename Bus>
+    int instr_rla(Core<Bus>& cpu) {
+        bool new_carry = (cpu.a >> 7) & 1;
+        cpu.a <<= 1;
+        cpu.a |= cpu.f.carry();
+
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV)) | (cpu.a & (FLAG_B5 | FLAG_B3)) | new_carry);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_rlca(Core<Bus>& cpu) {
+        cpu.a = std::rotl(cpu.a, 1);
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV)) | (cpu.a & (FLAG_B5 | FLAG_B3 | FLAG_C)));
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_rrca(Core<Bus>& cpu) {
+        bool new_carry = cpu.a & 1;
+        cpu.a = std::rotr(cpu.a, 1);
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV)) | (cpu.a & (FLAG_B5 | FLAG_B3)) | new_carry);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_djnz(Core<Bus>& cpu) {
+        set_register<Register::B>(cpu, get_register<Register::B>(cpu) - 1);
+        s8 offset = cpu.fetch_byte();
+        if (get_register<Register::B>(cpu) != 0) {
+            cpu.pc += offset;
+            return 13;
+        }
+        return 8;
+    }
+
+    template <typename Bus>
+    int instr_di(Core<Bus>& cpu) {
+        cpu.interrupts_enabled = false;
+        cpu.next_interrupts_enabled = false;
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_ei(Core<Bus>& cpu) {
+        cpu.next_interrupts_enabled = true;
+        return 4;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_rlc(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 value = cpu.read_byte(address);
+        u8 res = std::rotl(value, 1);
+
+        set_register<dst>(cpu, res);
+        cpu.write_byte(address, res);
+        cpu.f.set(flag_tables.sz53p[res] | (res & FLAG_C));
+        return 23;
+    }
+
+    template<Register src, typename Bus>
+    int instr_rlc(Core<Bus>& cpu) {
+        u8 value = get_register<src>(cpu);
+        u8 res = std::rotl(value, 1);
+        set_register<src>(cpu, res);
+        cpu.f.set(flag_tables.sz53p[res] | (res & FLAG_C));
+        return 8;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_rlc(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 value = cpu.read_byte(address);
+        u8 res = std::rotl(value, 1);
+
+        cpu.write_byte(address, res);
+        cpu.f.set(flag_tables.sz53p[res] | (res & FLAG_C));
+        return 23;
+    }
+
+    template <typename Bus>
+    u8 instr_rrc(Core<Bus>& cpu, u8 val) {
+        u8 res = std::rotr(val, 1);
+        cpu.f.set(flag_tables.sz53p[res] | (val & FLAG_C));
+        return res;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_rrc(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_rrc(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_rrc(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_rrc(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        return 23;
+    }
+
+    template<Register src, typename Bus>
+    int instr_rrc(Core<Bus>& cpu) {
+        u8 val = instr_rrc(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template <typename Bus>
+    inline u8 instr_rl(Core<Bus>& cpu, u8 val) {
+        const bool old_c = cpu.f.carry();
+
+        bool new_carry = ((s8)val) < 0;
+        val = (val << 1) | old_c;
+        cpu.f.set(flag_tables.sz53p[val] | new_carry);
+        return val;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_rl(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_rl(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_rl(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_rl(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<Register src, typename Bus>
+    int instr_rl(Core<Bus>& cpu) {
+        u8 val = instr_rl(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template <typename Bus>
+    inline u8 instr_rr(Core<Bus>& cpu, u8 val) {
+        const u8 old_c = cpu.f.carry() ? 0x80 : 0x00;
+        u8 res = (val >> 1) | old_c;
+        cpu.f.set(flag_tables.sz53p[res] | (val & FLAG_C));
+        return res;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_rr(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_rr(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_rr(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_rr(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<Register src, typename Bus>
+    int instr_rr(Core<Bus>& cpu) {
+        u8 val = instr_rr(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template <typename Bus>
+    inline u8 instr_sla(Core<Bus>& cpu, u8 val) {
+        bool new_carry = val >> 7;
+        val <<= 1;
+        cpu.f.set(flag_tables.sz53p[val] | new_carry);
+        return val;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_sla(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_sla(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_sla(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_sla(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<Register src, typename Bus>
+    int instr_sla(Core<Bus>& cpu) {
+        u8 val = instr_sla(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template <typename Bus>
+    inline u8 instr_sra(Core<Bus>& cpu, u8 val) {
+        bool new_carry = val & 1;
+        val = ((s8)val >> 1);
+        cpu.f.set(flag_tables.sz53p[val] | new_carry);
+        return val;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_sra(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_sra(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_sra(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_sra(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<Register src, typename Bus>
+    int instr_sra(Core<Bus>& cpu) {
+        u8 val = instr_sra(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template <typename Bus>
+    inline uint8_t instr_sll(Core<Bus>& cpu, u8 val) {
+        bool new_carry = ((s8)val) < 0;
+        val = (val << 1) | 1;
+        cpu.f.set(flag_tables.sz53p[val] | new_carry);
+        return val;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_sll(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_sll(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_sll(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = cpu.read_byte(address);
+        u8 res = instr_sll(cpu, val);
+        cpu.write_byte(address, res);
+        return 15;
+    }
+
+    template<Register src, typename Bus>
+    int instr_sll(Core<Bus>& cpu) {
+        u8 val = instr_sll(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template <typename Bus>
+    inline uint8_t instr_srl(Core<Bus>& cpu, u8 val) {
+        bool new_carry = val & 1;
+        val >>= 1;
+        cpu.f.set(flag_tables.sz53p[val] | new_carry);
+        return val;
+    }
+
+    template<AddressingMode src, Register dst, typename Bus>
+    int instr_srl(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_srl(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        set_register<dst>(cpu, val);
+        return 23;
+    }
+
+    template<AddressingMode src, typename Bus>
+    int instr_srl(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = instr_srl(cpu, cpu.read_byte(address));
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<Register src, typename Bus>
+    int instr_srl(Core<Bus>& cpu) {
+        u8 val = instr_srl(cpu, get_register<src>(cpu));
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template<int n, AddressingMode src, typename Bus>
+    int instr_bit(Core<Bus>& cpu) {
+        u16 addr = get_address<src>(cpu);
+        u8 val = cpu.read_byte(addr);
+        u8 res = val & (1 << n);
+        cpu.f.set((cpu.f.assemble() & FLAG_C)
+                  | (res & FLAG_S)
+                  | (res == 0 ? FLAG_Z | FLAG_PV : 0)
+                  | (addr & (FLAG_B5 | FLAG_B3))
+                  | FLAG_H);
+        return 20;
+    }
+
+    template<int n, Register src, typename Bus>
+    int instr_bit(Core<Bus>& cpu) {
+        u8 val = get_register<src>(cpu);
+        u8 res = val & (1 << n);
+        cpu.f.set((cpu.f.assemble() & FLAG_C)
+                  | (res & FLAG_S)
+                  | (res == 0 ? FLAG_Z | FLAG_PV : 0)
+                  | (val & (FLAG_B5 | FLAG_B3))
+                  | FLAG_H);
+        return 20;
+    }
+
+    template<int n, AddressingMode src, typename Bus>
+    int instr_res(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = cpu.read_byte(address);
+        val &= ~(1 << n);
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<u8 n, Register src, typename Bus>
+    int instr_res(Core<Bus>& cpu) {
+        u8 val = get_register<src>(cpu);
+        val &= ~(1 << n);
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template<int n, AddressingMode src, Register reg, typename Bus>
+    int instr_res(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = cpu.read_byte(address);
+        val &= ~(1 << n);
+        cpu.write_byte(address, val);
+        set_register<reg>(cpu, val);
+        return 23;
+    }
+
+    template<int n, AddressingMode src, typename Bus>
+    int instr_set(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = cpu.read_byte(address);
+        val |= (1 << n);
+        cpu.write_byte(address, val);
+        return 15;
+    }
+
+    template<int n, Register src, typename Bus>
+    int instr_set(Core<Bus>& cpu) {
+        u8 val = get_register<src>(cpu);
+        val |= (1 << n);
+        set_register<src>(cpu, val);
+        return 8;
+    }
+
+    template<int n, AddressingMode src, Register reg, typename Bus>
+    int instr_set(Core<Bus>& cpu) {
+        u16 address = get_address<src>(cpu);
+        u8 val = cpu.read_byte(address);
+        val |= (1 << n);
+        cpu.write_byte(address, val);
+        set_register<reg>(cpu, val);
+        return 23;
+    }
+
+    template <typename Bus>
+    int instr_im_1(Core<Bus>& cpu) {
+        cpu.interrupt_mode = 1;
+        return 8;
+    }
+
+    template <typename Bus>
+    int instr_cpl(Core<Bus>& cpu) {
+        cpu.a = ~cpu.a;
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV | FLAG_C)) | (cpu.a & (FLAG_B5 | FLAG_B3)) | FLAG_N | FLAG_H);
+        return 4;
+    }
+
+    template<u16 offset, typename Bus>
+    int instr_rst(Core<Bus>& cpu) {
+        stack_push<u16>(cpu, cpu.pc);
+        cpu.pc = offset;
+        return 11;
+    }
+
+    template <typename Bus>
+    int instr_rra(Core<Bus>& cpu) {
+        bool new_carry = cpu.a & 1;
+        cpu.a >>= 1;
+        cpu.a |= cpu.f.carry() << 7;
+
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV)) | (cpu.a & (FLAG_B5 | FLAG_B3)) | new_carry);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_daa(Core<Bus>& cpu) {
+        u8 offset = 0;
+        u8 lo4 = cpu.a & 0xF;
+        //u8 hi4 = (cpu.a >> 4) & 0xF;
+
+        u8 flags = cpu.f.assemble();
+        bool h = flags & FLAG_H;
+        bool c = flags & FLAG_C;
+
+        if (h || lo4 > 0x9) {
+            offset = 0x6;
+        }
+
+        if (c || cpu.a > 0x99) {
+            offset += 0x60;
+            c = true;
+        }
+
+        if (flags & FLAG_N) {
+            h = h && lo4 < 0x6;
+            cpu.a -= offset;
+        } else {
+            h = lo4 > 9;
+            cpu.a += offset;
+        }
+
+        cpu.f.set(flag_tables.sz53p[cpu.a] | (flags & FLAG_N) | (h ? FLAG_H : 0) | c);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_scf(Core<Bus>& cpu) {
+        cpu.f.set((cpu.f.assemble() & (FLAG_S | FLAG_Z | FLAG_PV)) | (cpu.a & (FLAG_B5 | FLAG_B3)) | FLAG_C);
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_ccf(Core<Bus>& cpu) {
+        u8 flags = cpu.f.assemble();
+        cpu.f.set((flags & (FLAG_S | FLAG_Z | FLAG_PV))
+                  | (cpu.a & (FLAG_B5 | FLAG_B3))
+                  | ((flags & FLAG_C) ? FLAG_H : FLAG_C));
+        return 4;
+    }
+
+    template <typename Bus>
+    int instr_rrd(Core<Bus>& cpu) {
+        u8 old_a = cpu.a;
+        u8 old_hl = cpu.read_byte(cpu.hl.raw);
+
+        u8 a_upper = old_a & 0xF0;
+        u8 a_lower = old_a & 0x0F;
+
+        u8 hl_upper = old_hl & 0xF0;
+        u8 hl_lower = old_hl & 0x0F;
+
+        cpu.a = a_upper | hl_lower;
+        u8 new_hl = (hl_upper >> 4) | (a_lower << 4);
+        cpu.write_byte(cpu.hl.raw, new_hl);
+
+        cpu.f.set(flag_tables.sz53p[cpu.a] | (cpu.f.assemble() & FLAG_C));
+
+        return 18;
+    }
+
+    template <typename Bus>
+    int instr_rld(Core<Bus>& cpu) {
+        u8 old_a = cpu.a;
+        u8 old_hl = cpu.read_byte(cpu.hl.raw);
+
+        u8 a_upper = old_a & 0xF0;
+        u8 a_lower = old_a & 0x0F;
+
+        u8 hl_upper = old_hl & 0xF0;
+        u8 hl_lower = old_hl & 0x0F;
+
+        cpu.a = a_upper | (hl_upper >> 4);
+        u8 new_hl = (hl_lower << 4) | a_lower;
+        cpu.write_byte(cpu.hl.raw, new_hl);
+
+        cpu.f.set(flag_tables.sz53p[cpu.a] | (cpu.f.assemble() & FLAG_C));
+
+        return 18;
+    }
+
+    // The prefix handlers dispatch through the tables below, so they're defined after them.
+    template <typename Bus>
+    int instr_cb(Core<Bus>& cpu);
+    template <typename Bus>
+    int instr_dd(Core<Bus>& cpu);
+    template <typename Bus>
+    int instr_ddcb(Core<Bus>& cpu);
+    template <typename Bus>
+    int instr_ed(Core<Bus>& cpu);
+    template <typename Bus>
+    int instr_fd(Core<Bus>& cpu);
+    template <typename Bus>
+    int instr_fdcb(Core<Bus>& cpu);
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> instructions[0x100] = {
+            /* 00 */ instr_nop,
+            /* 01 */ instr_ld<Register::BC, AddressingMode::Immediate>,
+            /* 02 */ instr_ld<AddressingMode::BC, Register::A>,
+            /* 03 */ instr_inc<Register::BC>,
+            /* 04 */ instr_inc<Register::B>,
+            /* 05 */ instr_dec<Register::B>,
+            /* 06 */ instr_ld<Register::B, AddressingMode::Immediate>,
+            /* 07 */ instr_rlca,
+            /* 08 */ instr_ex_af,
+            /* 09 */ instr_add<Register::HL, Register::BC>,
+            /* 0A */ instr_ld<Register::A, AddressingMode::BC>,
+            /* 0B */ instr_dec<Register::BC>,
+            /* 0C */ instr_inc<Register::C>,
+            /* 0D */ instr_dec<Register::C>,
+            /* 0E */ instr_ld<Register::C, AddressingMode::Immediate>,
+            /* 0F */ instr_rrca,
+            /* 10 */ instr_djnz,
+            /* 11 */ instr_ld<Register::DE, AddressingMode::Immediate>,
+            /* 12 */ instr_ld<AddressingMode::DE, Register::A>,
+            /* 13 */ instr_inc<Register::DE>,
+            /* 14 */ instr_inc<Register::D>,
+            /* 15 */ instr_dec<Register::D>,
+            /* 16 */ instr_ld<Register::D, AddressingMode::Immediate>,
+            /* 17 */ instr_rla,
+            /* 18 */ instr_jr<Condition::Always>,
+            /* 19 */ instr_add<Register::HL, Register::DE>,
+            /* 1A */ instr_ld<Register::A, AddressingMode::DE>,
+            /* 1B */ instr_dec<Register::DE>,
+            /* 1C */ instr_inc<Register::E>,
+            /* 1D */ instr_dec<Register::E>,
+            /* 1E */ instr_ld<Register::E, AddressingMode::Immediate>,
+            /* 1F */ instr_rra,
+            /* 20 */ instr_jr<Condition::NZ>,
+            /* 21 */ instr_ld<Register::HL, AddressingMode::Immediate>,
+            /* 22 */ instr_ld<AddressingMode::Indirect, Register::HL>,
+            /* 23 */ instr_inc<Register::HL>,
+            /* 24 */ instr_inc<Register::H>,
+            /* 25 */ instr_dec<Register::H>,
+            /* 26 */ instr_ld<Register::H, AddressingMode::Immediate>,
+            /* 27 */ instr_daa,
+            /* 28 */ instr_jr<Condition::Z>,
+            /* 29 */ instr_add<Register::HL, Register::HL>,
+            /* 2A */ instr_ld<Register::HL, AddressingMode::Indirect>,
+            /* 2B */ instr_dec<Register::HL>,
+            /* 2C */ instr_inc<Register::L>,
+            /* 2D */ instr_dec<Register::L>,
+            /* 2E */ instr_ld<Register::L, AddressingMode::Immediate>,
+            /* 2F */ instr_cpl,
+            /* 30 */ instr_jr<Condition::NC>,
+            /* 31 */ instr_ld<Register::SP, AddressingMode::Immediate>,
+            /* 32 */ instr_ld<AddressingMode::Indirect, Register::A>,
+            /* 33 */ instr_inc<Register::SP>,
+            /* 34 */ instr_inc<AddressingMode::HL>,
+            /* 35 */ instr_dec<AddressingMode::HL>,
+            /* 36 */ instr_ld<AddressingMode::HL, AddressingMode::Immediate>,
+            /* 37 */ instr_scf,
+            /* 38 */ instr_jr<Condition::C>,
+            /* 39 */ instr_add<Register::HL, Register::SP>,
+            /* 3A */ instr_ld<Register::A, AddressingMode::Indirect>,
+            /* 3B */ instr_dec<Register::SP>,
+            /* 3C */ instr_inc<Register::A>,
+            /* 3D */ instr_dec<Register::A>,
+            /* 3E */ instr_ld<Register::A, AddressingMode::Immediate>,
+            /* 3F */ instr_ccf,
+            /* 40 */ instr_ld<Register::B, Register::B>,
+            /* 41 */ instr_ld<Register::B, Register::C>,
+            /* 42 */ instr_ld<Register::B, Register::D>,
+            /* 43 */ instr_ld<Register::B, Register::E>,
+            /* 44 */ instr_ld<Register::B, Register::H>,
+            /* 45 */ instr_ld<Register::B, Register::L>,
+            /* 46 */ instr_ld<Register::B, AddressingMode::HL>,
+            /* 47 */ instr_ld<Register::B, Register::A>,
+            /* 48 */ instr_ld<Register::C, Register::B>,
+            /* 49 */ instr_ld<Register::C, Register::C>,
+            /* 4A */ instr_ld<Register::C, Register::D>,
+            /* 4B */ instr_ld<Register::C, Register::E>,
+            /* 4C */ instr_ld<Register::C, Register::H>,
+            /* 4D */ instr_ld<Register::C, Register::L>,
+            /* 4E */ instr_ld<Register::C, AddressingMode::HL>,
+            /* 4F */ instr_ld<Register::C, Register::A>,
+            /* 50 */ instr_ld<Register::D, Register::B>,
+            /* 51 */ instr_ld<Register::D, Register::C>,
+            /* 52 */ instr_ld<Register::D, Register::D>,
+            /* 53 */ instr_ld<Register::D, Register::E>,
+            /* 54 */ instr_ld<Register::D, Register::H>,
+            /* 55 */ instr_ld<Register::D, Register::L>,
+            /* 56 */ instr_ld<Register::D, AddressingMode::HL>,
+            /* 57 */ instr_ld<Register::D, Register::A>,
+            /* 58 */ instr_ld<Register::E, Register::B>,
+            /* 59 */ instr_ld<Register::E, Register::C>,
+            /* 5A */ instr_ld<Register::E, Register::D>,
+            /* 5B */ instr_ld<Register::E, Register::E>,
+            /* 5C */ instr_ld<Register::E, Register::H>,
+            /* 5D */ instr_ld<Register::E, Register::L>,
+            /* 5E */ instr_ld<Register::E, AddressingMode::HL>,
+            /* 5F */ instr_ld<Register::E, Register::A>,
+            /* 60 */ instr_ld<Register::H, Register::B>,
+            /* 61 */ instr_ld<Register::H, Register::C>,
+            /* 62 */ instr_ld<Register::H, Register::D>,
+            /* 63 */ instr_ld<Register::H, Register::E>,
+            /* 64 */ instr_ld<Register::H, Register::H>,
+            /* 65 */ instr_ld<Register::H, Register::L>,
+            /* 66 */ instr_ld<Register::H, AddressingMode::HL>,
+            /* 67 */ instr_ld<Register::H, Register::A>,
+            /* 68 */ instr_ld<Register::L, Register::B>,
+            /* 69 */ instr_ld<Register::L, Register::C>,
+            /* 6A */ instr_ld<Register::L, Register::D>,
+            /* 6B */ instr_ld<Register::L, Register::E>,
+            /* 6C */ instr_ld<Register::L, Register::H>,
+            /* 6D */ instr_ld<Register::L, Register::L>,
+            /* 6E */ instr_ld<Register::L, AddressingMode::HL>,
+            /* 6F */ instr_ld<Register::L, Register::A>,
+            /* 70 */ instr_ld<AddressingMode::HL, Register::B>,
+            /* 71 */ instr_ld<AddressingMode::HL, Register::C>,
+            /* 72 */ instr_ld<AddressingMode::HL, Register::D>,
+            /* 73 */ instr_ld<AddressingMode::HL, Register::E>,
+            /* 74 */ instr_ld<AddressingMode::HL, Register::H>,
+            /* 75 */ instr_ld<AddressingMode::HL, Register::L>,
+            /* 76 */ instr_halt,
+            /* 77 */ instr_ld<AddressingMode::HL, Register::A>,
+            /* 78 */ instr_ld<Register::A, Register::B>,
+            /* 79 */ instr_ld<Register::A, Register::C>,
+            /* 7A */ instr_ld<Register::A, Register::D>,
+            /* 7B */ instr_ld<Register::A, Register::E>,
+            /* 7C */ instr_ld<Register::A, Register::H>,
+            /* 7D */ instr_ld<Register::A, Register::L>,
+            /* 7E */ instr_ld<Register::A, AddressingMode::HL>,
+            /* 7F */ instr_ld<Register::A, Register::A>,
+            /* 80 */ instr_add<Register::A, Register::B>,
+            /* 81 */ instr_add<Register::A, Register::C>,
+            /* 82 */ instr_add<Register::A, Register::D>,
+            /* 83 */ instr_add<Register::A, Register::E>,
+            /* 84 */ instr_add<Register::A, Register::H>,
+            /* 85 */ instr_add<Register::A, Register::L>,
+            /* 86 */ instr_add<Register::A, AddressingMode::HL>,
+            /* 87 */ instr_add<Register::A, Register::A>,
+            /* 88 */ instr_adc<Register::A, Register::B>,
+            /* 89 */ instr_adc<Register::A, Register::C>,
+            /* 8A */ instr_adc<Register::A, Register::D>,
+            /* 8B */ instr_adc<Register::A, Register::E>,
+            /* 8C */ instr_adc<Register::A, Register::H>,
+            /* 8D */ instr_adc<Register::A, Register::L>,
+            /* 8E */ instr_adc<Register::A, AddressingMode::HL>,
+            /* 8F */ instr_adc<Register::A, Register::A>,
+            /* 90 */ instr_sub<Register::B>,
+            /* 91 */ instr_sub<Register::C>,
+            /* 92 */ instr_sub<Register::D>,
+            /* 93 */ instr_sub<Register::E>,
+            /* 94 */ instr_sub<Register::H>,
+            /* 95 */ instr_sub<Register::L>,
+            /* 96 */ instr_sub<AddressingMode::HL>,
+            /* 97 */ instr_sub<Register::A>,
+            /* 98 */ instr_sbc<Register::A, Register::B>,
+            /* 99 */ instr_sbc<Register::A, Register::C>,
+            /* 9A */ instr_sbc<Register::A, Register::D>,
+            /* 9B */ instr_sbc<Register::A, Register::E>,
+            /* 9C */ instr_sbc<Register::A, Register::H>,
+            /* 9D */ instr_sbc<Register::A, Register::L>,
+            /* 9E */ instr_sbc<Register::A, AddressingMode::HL>,
+            /* 9F */ instr_sbc<Register::A, Register::A>,
+            /* A0 */ instr_and<Register::B>,
+            /* A1 */ instr_and<Register::C>,
+            /* A2 */ instr_and<Register::D>,
+            /* A3 */ instr_and<Register::E>,
+            /* A4 */ instr_and<Register::H>,
+            /* A5 */ instr_and<Register::L>,
+            /* A6 */ instr_and<AddressingMode::HL>,
+            /* A7 */ instr_and<Register::A>,
+            /* A8 */ instr_xor<Register::B>,
+            /* A9 */ instr_xor<Register::C>,
+            /* AA */ instr_xor<Register::D>,
+            /* AB */ instr_xor<Register::E>,
+            /* AC */ instr_xor<Register::H>,
+            /* AD */ instr_xor<Register::L>,
+            /* AE */ instr_xor<AddressingMode::HL>,
+            /* AF */ instr_xor<Register::A>,
+            /* B0 */ instr_or<Register::B>,
+            /* B1 */ instr_or<Register::C>,
+            /* B2 */ instr_or<Register::D>,
+            /* B3 */ instr_or<Register::E>,
+            /* B4 */ instr_or<Register::H>,
+            /* B5 */ instr_or<Register::L>,
+            /* B6 */ instr_or<AddressingMode::HL>,
+            /* B7 */ instr_or<Register::A>,
+            /* B8 */ instr_cp<Register::B>,
+            /* B9 */ instr_cp<Register::C>,
+            /* BA */ instr_cp<Register::D>,
+            /* BB */ instr_cp<Register::E>,
+            /* BC */ instr_cp<Register::H>,
+            /* BD */ instr_cp<Register::L>,
+            /* BE */ instr_cp<AddressingMode::HL>,
+            /* BF */ instr_cp<Register::A>,
+            /* C0 */ instr_ret<Condition::NZ>,
+            /* C1 */ instr_pop<Register::BC>,
+            /* C2 */ instr_jp<Condition::NZ, AddressingMode::Indirect>,
+            /* C3 */ instr_jp<Condition::Always, AddressingMode::Indirect>,
+            /* C4 */ instr_call<Condition::NZ>,
+            /* C5 */ instr_push<Register::BC>,
+            /* C6 */ instr_add<Register::A, AddressingMode::Immediate>,
+            /* C7 */ unimplemented_instr<0xC7>,
+            /* C8 */ instr_ret<Condition::Z>,
+            /* C9 */ instr_ret<Condition::Always>,
+            /* CA */ instr_jp<Condition::Z, AddressingMode::Indirect>,
+            /* CB */ instr_cb,
+            /* CC */ instr_call<Condition::Z>,
+            /* CD */ instr_call<Condition::Always>,
+            /* CE */ instr_adc<Register::A, AddressingMode::Immediate>,
+            /* CF */ instr_rst<0x08>,
+            /* D0 */ instr_ret<Condition::NC>,
+            /* D1 */ instr_pop<Register::DE>,
+            /* D2 */ instr_jp<Condition::NC, AddressingMode::Indirect>,
+            /* D3 */ instr_out<AddressingMode::Immediate, Register::A>,
+            /* D4 */ instr_call<Condition::NC>,
+            /* D5 */ instr_push<Register::DE>,
+            /* D6 */ instr_sub<AddressingMode::Immediate>,
+            /* D7 */ instr_rst<0x10>,
+            /* D8 */ instr_ret<Condition::C>,
+            /* D9 */ instr_exx,
+            /* DA */ instr_jp<Condition::C, AddressingMode::Indirect>,
+            /* DB */ instr_in,
+            /* DC */ instr_call<Condition::C>,
+            /* DD */ instr_dd,
+            /* DE */ instr_sbc<Register::A, AddressingMode::Immediate>,
+            /* DF */ instr_rst<0x18>,
+            /* E0 */ instr_ret<Condition::PO>,
+            /* E1 */ instr_pop<Register::HL>,
+            /* E2 */ instr_jp<Condition::PO, AddressingMode::Indirect>,
+            /* E3 */ unimplemented_instr<0xE3>,
+            /* E4 */ instr_call<Condition::PO>,
+            /* E5 */ instr_push<Register::HL>,
+            /* E6 */ instr_and<AddressingMode::Immediate>,
+            /* E7 */ instr_rst<0x20>,
+            /* E8 */ instr_ret<Condition::PE>,
+            /* E9 */ instr_jp<Condition::Always, AddressingMode::HL>,
+            /* EA */ instr_jp<Condition::PE, AddressingMode::Indirect>,
+            /* EB */ instr_ex_de_hl,
+            /* EC */ instr_call<Condition::PE>,
+            /* ED */ instr_ed,
+            /* EE */ instr_xor<AddressingMode::Immediate>,
+            /* EF */ instr_rst<0x28>,
+            /* F0 */ instr_ret<Condition::P>,
+            /* F1 */ instr_pop<Register::AF>,
+            /* F2 */ instr_jp<Condition::P, AddressingMode::Indirect>,
+            /* F3 */ instr_di,
+            /* F4 */ instr_call<Condition::P>,
+            /* F5 */ instr_push<Register::AF>,
+            /* F6 */ instr_or<AddressingMode::Immediate>,
+            /* F7 */ instr_rst<0x30>,
+            /* F8 */ instr_ret<Condition::M>,
+            /* F9 */ instr_ld<Register::SP, Register::HL>,
+            /* FA */ instr_jp<Condition::M, AddressingMode::Indirect>,
+            /* FB */ instr_ei,
+            /* FC */ instr_call<Condition::M>,
+            /* FD */ instr_fd,
+            /* FE */ instr_cp<AddressingMode::Immediate>,
+            /* FF */ instr_rst<0x38>,
+    };
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> cb_instructions[0x100] = {
+            /* CB 00 */ instr_rlc<Register::B>,
+            /* CB 01 */ instr_rlc<Register::C>,
+            /* CB 02 */ instr_rlc<Register::D>,
+            /* CB 03 */ instr_rlc<Register::E>,
+            /* CB 04 */ instr_rlc<Register::H>,
+            /* CB 05 */ instr_rlc<Register::L>,
+            /* CB 06 */ instr_rlc<AddressingMode::HL>,
+            /* CB 07 */ instr_rlc<Register::A>,
+            /* CB 08 */ instr_rrc<Register::B>,
+            /* CB 09 */ instr_rrc<Register::C>,
+            /* CB 0A */ instr_rrc<Register::D>,
+            /* CB 0B */ instr_rrc<Register::E>,
+            /* CB 0C */ instr_rrc<Register::H>,
+            /* CB 0D */ instr_rrc<Register::L>,
+            /* CB 0E */ instr_rrc<AddressingMode::HL>,
+            /* CB 0F */ instr_rrc<Register::A>,
+            /* CB 10 */ instr_rl<Register::B>,
+            /* CB 11 */ instr_rl<Register::C>,
+            /* CB 12 */ instr_rl<Register::D>,
+            /* CB 13 */ instr_rl<Register::E>,
+            /* CB 14 */ instr_rl<Register::H>,
+            /* CB 15 */ instr_rl<Register::L>,
+            /* CB 16 */ instr_rl<AddressingMode::HL>,
+            /* CB 17 */ instr_rl<Register::A>,
+            /* CB 18 */ instr_rr<Register::B>,
+            /* CB 19 */ instr_rr<Register::C>,
+            /* CB 1A */ instr_rr<Register::D>,
+            /* CB 1B */ instr_rr<Register::E>,
+            /* CB 1C */ instr_rr<Register::H>,
+            /* CB 1D */ instr_rr<Register::L>,
+            /* CB 1E */ instr_rr<AddressingMode::HL>,
+            /* CB 1F */ instr_rr<Register::A>,
+            /* CB 20 */ instr_sla<Register::B>,
+            /* CB 21 */ instr_sla<Register::C>,
+            /* CB 22 */ instr_sla<Register::D>,
+            /* CB 23 */ instr_sla<Register::E>,
+            /* CB 24 */ instr_sla<Register::H>,
+            /* CB 25 */ instr_sla<Register::L>,
+            /* CB 26 */ instr_sla<AddressingMode::HL>,
+            /* CB 27 */ instr_sla<Register::A>,
+            /* CB 28 */ instr_sra<Register::B>,
+            /* CB 29 */ instr_sra<Register::C>,
+            /* CB 2A */ instr_sra<Register::D>,
+            /* CB 2B */ instr_sra<Register::E>,
+            /* CB 2C */ instr_sra<Register::H>,
+            /* CB 2D */ instr_sra<Register::L>,
+            /* CB 2E */ instr_sra<AddressingMode::HL>,
+            /* CB 2F */ instr_sra<Register::A>,
+            /* CB 30 */ instr_sll<Register::B>,
+            /* CB 31 */ instr_sll<Register::C>,
+            /* CB 32 */ instr_sll<Register::D>,
+            /* CB 33 */ instr_sll<Register::E>,
+            /* CB 34 */ instr_sll<Register::H>,
+            /* CB 35 */ instr_sll<Register::L>,
+            /* CB 36 */ instr_sll<AddressingMode::HL>,
+            /* CB 37 */ instr_sll<Register::A>,
+            /* CB 38 */ instr_srl<Register::B>,
+            /* CB 39 */ instr_srl<Register::C>,
+            /* CB 3A */ instr_srl<Register::D>,
+            /* CB 3B */ instr_srl<Register::E>,
+            /* CB 3C */ instr_srl<Register::H>,
+            /* CB 3D */ instr_srl<Register::L>,
+            /* CB 3E */ instr_srl<AddressingMode::HL>,
+            /* CB 3F */ instr_srl<Register::A>,
+            /* CB 40 */ instr_bit<0, Register::B>,
+            /* CB 41 */ instr_bit<0, Register::C>,
+            /* CB 42 */ instr_bit<0, Register::D>,
+            /* CB 43 */ instr_bit<0, Register::E>,
+            /* CB 44 */ instr_bit<0, Register::H>,
+            /* CB 45 */ instr_bit<0, Register::L>,
+            /* CB 46 */ instr_bit<0, AddressingMode::HL>,
+            /* CB 47 */ instr_bit<0, Register::A>,
+            /* CB 48 */ instr_bit<1, Register::B>,
+            /* CB 49 */ instr_bit<1, Register::C>,
+            /* CB 4A */ instr_bit<1, Register::D>,
+            /* CB 4B */ instr_bit<1, Register::E>,
+            /* CB 4C */ instr_bit<1, Register::H>,
+            /* CB 4D */ instr_bit<1, Register::L>,
+            /* CB 4E */ instr_bit<1, AddressingMode::HL>,
+            /* CB 4F */ instr_bit<1, Register::A>,
+            /* CB 50 */ instr_bit<2, Register::B>,
+            /* CB 51 */ instr_bit<2, Register::C>,
+            /* CB 52 */ instr_bit<2, Register::D>,
+            /* CB 53 */ instr_bit<2, Register::E>,
+            /* CB 54 */ instr_bit<2, Register::H>,
+            /* CB 55 */ instr_bit<2, Register::L>,
+            /* CB 56 */ instr_bit<2, AddressingMode::HL>,
+            /* CB 57 */ instr_bit<2, Register::A>,
+            /* CB 58 */ instr_bit<3, Register::B>,
+            /* CB 59 */ instr_bit<3, Register::C>,
+            /* CB 5A */ instr_bit<3, Register::D>,
+            /* CB 5B */ instr_bit<3, Register::E>,
+            /* CB 5C */ instr_bit<3, Register::H>,
+            /* CB 5D */ instr_bit<3, Register::L>,
+            /* CB 5E */ instr_bit<3, AddressingMode::HL>,
+            /* CB 5F */ instr_bit<3, Register::A>,
+            /* CB 60 */ instr_bit<4, Register::B>,
+            /* CB 61 */ instr_bit<4, Register::C>,
+            /* CB 62 */ instr_bit<4, Register::D>,
+            /* CB 63 */ instr_bit<4, Register::E>,
+            /* CB 64 */ instr_bit<4, Register::H>,
+            /* CB 65 */ instr_bit<4, Register::L>,
+            /* CB 66 */ instr_bit<4, AddressingMode::HL>,
+            /* CB 67 */ instr_bit<4, Register::A>,
+            /* CB 68 */ instr_bit<5, Register::B>,
+            /* CB 69 */ instr_bit<5, Register::C>,
+            /* CB 6A */ instr_bit<5, Register::D>,
+            /* CB 6B */ instr_bit<5, Register::E>,
+            /* CB 6C */ instr_bit<5, Register::H>,
+            /* CB 6D */ instr_bit<5, Register::L>,
+            /* CB 6E */ instr_bit<5, AddressingMode::HL>,
+            /* CB 6F */ instr_bit<5, Register::A>,
+            /* CB 70 */ instr_bit<6, Register::B>,
+            /* CB 71 */ instr_bit<6, Register::C>,
+            /* CB 72 */ instr_bit<6, Register::D>,
+            /* CB 73 */ instr_bit<6, Register::E>,
+            /* CB 74 */ instr_bit<6, Register::H>,
+            /* CB 75 */ instr_bit<6, Register::L>,
+            /* CB 76 */ instr_bit<6, AddressingMode::HL>,
+            /* CB 77 */ instr_bit<6, Register::A>,
+            /* CB 78 */ instr_bit<7, Register::B>,
+            /* CB 79 */ instr_bit<7, Register::C>,
+            /* CB 7A */ instr_bit<7, Register::D>,
+            /* CB 7B */ instr_bit<7, Register::E>,
+            /* CB 7C */ instr_bit<7, Register::H>,
+            /* CB 7D */ instr_bit<7, Register::L>,
+            /* CB 7E */ instr_bit<7, AddressingMode::HL>,
+            /* CB 7F */ instr_bit<7, Register::A>,
+            /* CB 80 */ instr_res<0, Register::B>,
+            /* CB 81 */ instr_res<0, Register::C>,
+            /* CB 82 */ instr_res<0, Register::D>,
+            /* CB 83 */ instr_res<0, Register::E>,
+            /* CB 84 */ instr_res<0, Register::H>,
+            /* CB 85 */ instr_res<0, Register::L>,
+            /* CB 86 */ instr_res<0, AddressingMode::HL>,
+            /* CB 87 */ instr_res<0, Register::A>,
+            /* CB 88 */ instr_res<1, Register::B>,
+            /* CB 89 */ instr_res<1, Register::C>,
+            /* CB 8A */ instr_res<1, Register::D>,
+            /* CB 8B */ instr_res<1, Register::E>,
+            /* CB 8C */ instr_res<1, Register::H>,
+            /* CB 8D */ instr_res<1, Register::L>,
+            /* CB 8E */ instr_res<1, AddressingMode::HL>,
+            /* CB 8F */ instr_res<1, Register::A>,
+            /* CB 90 */ instr_res<2, Register::B>,
+            /* CB 91 */ instr_res<2, Register::C>,
+            /* CB 92 */ instr_res<2, Register::D>,
+            /* CB 93 */ instr_res<2, Register::E>,
+            /* CB 94 */ instr_res<2, Register::H>,
+            /* CB 95 */ instr_res<2, Register::L>,
+            /* CB 96 */ instr_res<2, AddressingMode::HL>,
+            /* CB 97 */ instr_res<2, Register::A>,
+            /* CB 98 */ instr_res<3, Register::B>,
+            /* CB 99 */ instr_res<3, Register::C>,
+            /* CB 9A */ instr_res<3, Register::D>,
+            /* CB 9B */ instr_res<3, Register::E>,
+            /* CB 9C */ instr_res<3, Register::H>,
+            /* CB 9D */ instr_res<3, Register::L>,
+            /* CB 9E */ instr_res<3, AddressingMode::HL>,
+            /* CB 9F */ instr_res<3, Register::A>,
+            /* CB A0 */ instr_res<4, Register::B>,
+            /* CB A1 */ instr_res<4, Register::C>,
+            /* CB A2 */ instr_res<4, Register::D>,
+            /* CB A3 */ instr_res<4, Register::E>,
+            /* CB A4 */ instr_res<4, Register::H>,
+            /* CB A5 */ instr_res<4, Register::L>,
+            /* CB A6 */ instr_res<4, AddressingMode::HL>,
+            /* CB A7 */ instr_res<4, Register::A>,
+            /* CB A8 */ instr_res<5, Register::B>,
+            /* CB A9 */ instr_res<5, Register::C>,
+            /* CB AA */ instr_res<5, Register::D>,
+            /* CB AB */ instr_res<5, Register::E>,
+            /* CB AC */ instr_res<5, Register::H>,
+            /* CB AD */ instr_res<5, Register::L>,
+            /* CB AE */ instr_res<5, AddressingMode::HL>,
+            /* CB AF */ instr_res<5, Register::A>,
+            /* CB B0 */ instr_res<6, Register::B>,
+            /* CB B1 */ instr_res<6, Register::C>,
+            /* CB B2 */ instr_res<6, Register::D>,
+            /* CB B3 */ instr_res<6, Register::E>,
+            /* CB B4 */ instr_res<6, Register::H>,
+            /* CB B5 */ instr_res<6, Register::L>,
+            /* CB B6 */ instr_res<6, AddressingMode::HL>,
+            /* CB B7 */ instr_res<6, Register::A>,
+            /* CB B8 */ instr_res<7, Register::B>,
+            /* CB B9 */ instr_res<7, Register::C>,
+            /* CB BA */ instr_res<7, Register::D>,
+            /* CB BB */ instr_res<7, Register::E>,
+            /* CB BC */ instr_res<7, Register::H>,
+            /* CB BD */ instr_res<7, Register::L>,
+            /* CB BE */ instr_res<7, AddressingMode::HL>,
+            /* CB BF */ instr_res<7, Register::A>,
+            /* CB C0 */ instr_set<0, Register::B>,
+            /* CB C1 */ instr_set<0, Register::C>,
+            /* CB C2 */ instr_set<0, Register::D>,
+            /* CB C3 */ instr_set<0, Register::E>,
+            /* CB C4 */ instr_set<0, Register::H>,
+            /* CB C5 */ instr_set<0, Register::L>,
+            /* CB C6 */ instr_set<0, AddressingMode::HL>,
+            /* CB C7 */ instr_set<0, Register::A>,
+            /* CB C8 */ instr_set<1, Register::B>,
+            /* CB C9 */ instr_set<1, Register::C>,
+            /* CB CA */ instr_set<1, Register::D>,
+            /* CB CB */ instr_set<1, Register::E>,
+            /* CB CC */ instr_set<1, Register::H>,
+            /* CB CD */ instr_set<1, Register::L>,
+            /* CB CE */ instr_set<1, AddressingMode::HL>,
+            /* CB CF */ instr_set<1, Register::A>,
+            /* CB D0 */ instr_set<2, Register::B>,
+            /* CB D1 */ instr_set<2, Register::C>,
+            /* CB D2 */ instr_set<2, Register::D>,
+            /* CB D3 */ instr_set<2, Register::E>,
+            /* CB D4 */ instr_set<2, Register::H>,
+            /* CB D5 */ instr_set<2, Register::L>,
+            /* CB D6 */ instr_set<2, AddressingMode::HL>,
+            /* CB D7 */ instr_set<2, Register::A>,
+            /* CB D8 */ instr_set<3, Register::B>,
+            /* CB D9 */ instr_set<3, Register::C>,
+            /* CB DA */ instr_set<3, Register::D>,
+            /* CB DB */ instr_set<3, Register::E>,
+            /* CB DC */ instr_set<3, Register::H>,
+            /* CB DD */ instr_set<3, Register::L>,
+            /* CB DE */ instr_set<3, AddressingMode::HL>,
+            /* CB DF */ instr_set<3, Register::A>,
+            /* CB E0 */ instr_set<4, Register::B>,
+            /* CB E1 */ instr_set<4, Register::C>,
+            /* CB E2 */ instr_set<4, Register::D>,
+            /* CB E3 */ instr_set<4, Register::E>,
+            /* CB E4 */ instr_set<4, Register::H>,
+            /* CB E5 */ instr_set<4, Register::L>,
+            /* CB E6 */ instr_set<4, AddressingMode::HL>,
+            /* CB E7 */ instr_set<4, Register::A>,
+            /* CB E8 */ instr_set<5, Register::B>,
+            /* CB E9 */ instr_set<5, Register::C>,
+            /* CB EA */ instr_set<5, Register::D>,
+            /* CB EB */ instr_set<5, Register::E>,
+            /* CB EC */ instr_set<5, Register::H>,
+            /* CB ED */ instr_set<5, Register::L>,
+            /* CB EE */ instr_set<5, AddressingMode::HL>,
+            /* CB EF */ instr_set<5, Register::A>,
+            /* CB F0 */ instr_set<6, Register::B>,
+            /* CB F1 */ instr_set<6, Register::C>,
+            /* CB F2 */ instr_set<6, Register::D>,
+            /* CB F3 */ instr_set<6, Register::E>,
+            /* CB F4 */ instr_set<6, Register::H>,
+            /* CB F5 */ instr_set<6, Register::L>,
+            /* CB F6 */ instr_set<6, AddressingMode::HL>,
+            /* CB F7 */ instr_set<6, Register::A>,
+            /* CB F8 */ instr_set<7, Register::B>,
+            /* CB F9 */ instr_set<7, Register::C>,
+            /* CB FA */ instr_set<7, Register::D>,
+            /* CB FB */ instr_set<7, Register::E>,
+            /* CB FC */ instr_set<7, Register::H>,
+            /* CB FD */ instr_set<7, Register::L>,
+            /* CB FE */ instr_set<7, AddressingMode::HL>,
+            /* CB FF */ instr_set<7, Register::A>
+    };
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> dd_instructions[0x100] = {
+            /* DD 00 */ instructions<Bus>[0x00],
+            /* DD 01 */ instructions<Bus>[0x01],
+            /* DD 02 */ instructions<Bus>[0x02],
+            /* DD 03 */ instructions<Bus>[0x03],
+            /* DD 04 */ instructions<Bus>[0x04],
+            /* DD 05 */ instructions<Bus>[0x05],
+            /* DD 06 */ instructions<Bus>[0x06],
+            /* DD 07 */ instructions<Bus>[0x07],
+            /* DD 08 */ instructions<Bus>[0x08],
+            /* DD 09 */ instr_add<Register::IX, Register::BC>,
+            /* DD 0A */ instructions<Bus>[0x0A],
+            /* DD 0B */ instructions<Bus>[0x0B],
+            /* DD 0C */ instructions<Bus>[0x0C],
+            /* DD 0D */ instructions<Bus>[0x0D],
+            /* DD 0E */ instructions<Bus>[0x0E],
+            /* DD 0F */ instructions<Bus>[0x0F],
+            /* DD 10 */ instructions<Bus>[0x10],
+            /* DD 11 */ instructions<Bus>[0x11],
+            /* DD 12 */ instructions<Bus>[0x12],
+            /* DD 13 */ instructions<Bus>[0x13],
+            /* DD 14 */ instructions<Bus>[0x14],
+            /* DD 15 */ instructions<Bus>[0x15],
+            /* DD 16 */ instructions<Bus>[0x16],
+            /* DD 17 */ instructions<Bus>[0x17],
+            /* DD 18 */ instructions<Bus>[0x18],
+            /* DD 19 */ instr_add<Register::IX, Register::DE>,
+            /* DD 1A */ instructions<Bus>[0x1A],
+            /* DD 1B */ instructions<Bus>[0x1B],
+            /* DD 1C */ instructions<Bus>[0x1C],
+            /* DD 1D */ instructions<Bus>[0x1D],
+            /* DD 1E */ instructions<Bus>[0x1E],
+            /* DD 1F */ instructions<Bus>[0x1F],
+            /* DD 20 */ instructions<Bus>[0x20],
+            /* DD 21 */ instr_ld<Register::IX, AddressingMode::Immediate>,
+            /* DD 22 */ instr_ld<AddressingMode::Indirect, Register::IX>,
+            /* DD 23 */ instr_inc<Register::IX>,
+            /* DD 24 */ instr_inc<Register::IXH>,
+            /* DD 25 */ instr_dec<Register::IXH>,
+            /* DD 26 */ instr_ld<Register::IXH, AddressingMode::Immediate>,
+            /* DD 27 */ instructions<Bus>[0x27],
+            /* DD 28 */ instructions<Bus>[0x28],
+            /* DD 29 */ instr_add<Register::IX, Register::IX>,
+            /* DD 2A */ instr_ld<Register::IX, AddressingMode::Indirect>,
+            /* DD 2B */ instr_dec<Register::IX>,
+            /* DD 2C */ instr_inc<Register::IXL>,
+            /* DD 2D */ instr_dec<Register::IXL>,
+            /* DD 2E */ instr_ld<Register::IXL, AddressingMode::Immediate>,
+            /* DD 2F */ instructions<Bus>[0x2F],
+            /* DD 30 */ instructions<Bus>[0x30],
+            /* DD 31 */ instructions<Bus>[0x31],
+            /* DD 32 */ instructions<Bus>[0x32],
+            /* DD 33 */ instructions<Bus>[0x33],
+            /* DD 34 */ instr_inc<AddressingMode::IXPlus>,
+            /* DD 35 */ instr_dec<AddressingMode::IXPlus>,
+            /* DD 36 */ instr_ld<AddressingMode::IXPlus, AddressingMode::Immediate>,
+            /* DD 37 */ instructions<Bus>[0x37],
+            /* DD 38 */ instructions<Bus>[0x38],
+            /* DD 39 */ instr_add<Register::IX, Register::SP>,
+            /* DD 3A */ instructions<Bus>[0x3A],
+            /* DD 3B */ instructions<Bus>[0x3B],
+            /* DD 3C */ instructions<Bus>[0x3C],
+            /* DD 3D */ instructions<Bus>[0x3D],
+            /* DD 3E */ instructions<Bus>[0x3E],
+            /* DD 3F */ instructions<Bus>[0x3F],
+            /* DD 40 */ instructions<Bus>[0x40],
+            /* DD 41 */ instructions<Bus>[0x41],
+            /* DD 42 */ instructions<Bus>[0x42],
+            /* DD 43 */ instructions<Bus>[0x43],
+            /* DD 44 */ instr_ld<Register::B, Register::IXH>,
+            /* DD 45 */ instr_ld<Register::B, Register::IXL>,
+            /* DD 46 */ instr_ld<Register::B, AddressingMode::IXPlus>,
+            /* DD 47 */ instructions<Bus>[0x47],
+            /* DD 48 */ instructions<Bus>[0x48],
+            /* DD 49 */ instructions<Bus>[0x49],
+            /* DD 4A */ instructions<Bus>[0x4A],
+            /* DD 4B */ instructions<Bus>[0x4B],
+            /* DD 4C */ instr_ld<Register::C, Register::IXH>,
+            /* DD 4D */ instr_ld<Register::C, Register::IXL>,
+            /* DD 4E */ instr_ld<Register::C, AddressingMode::IXPlus>,
+            /* DD 4F */ instructions<Bus>[0x4F],
+            /* DD 50 */ instructions<Bus>[0x50],
+            /* DD 51 */ instructions<Bus>[0x51],
+            /* DD 52 */ instructions<Bus>[0x52],
+            /* DD 53 */ instructions<Bus>[0x53],
+            /* DD 54 */ instr_ld<Register::D, Register::IXH>,
+            /* DD 55 */ instr_ld<Register::D, Register::IXL>,
+            /* DD 56 */ instr_ld<Register::D, AddressingMode::IXPlus>,
+            /* DD 57 */ instructions<Bus>[0x57],
+            /* DD 58 */ instructions<Bus>[0x58],
+            /* DD 59 */ instructions<Bus>[0x59],
+            /* DD 5A */ instructions<Bus>[0x5A],
+            /* DD 5B */ instructions<Bus>[0x5B],
+            /* DD 5C */ instr_ld<Register::E, Register::IXH>,
+            /* DD 5D */ instr_ld<Register::E, Register::IXL>,
+            /* DD 5E */ instr_ld<Register::E, AddressingMode::IXPlus>,
+            /* DD 5F */ instructions<Bus>[0x5F],
+            /* DD 60 */ instr_ld<Register::IXH, Register::B>,
+            /* DD 61 */ instr_ld<Register::IXH, Register::C>,
+            /* DD 62 */ instr_ld<Register::IXH, Register::D>,
+            /* DD 63 */ instr_ld<Register::IXH, Register::E>,
+            /* DD 64 */ instr_ld<Register::IXH, Register::IXH>,
+            /* DD 65 */ instr_ld<Register::IXH, Register::IXL>,
+            /* DD 66 */ instr_ld<Register::H, AddressingMode::IXPlus>,
+            /* DD 67 */ instr_ld<Register::IXH, Register::A>,
+            /* DD 68 */ instr_ld<Register::IXL, Register::B>,
+            /* DD 69 */ instr_ld<Register::IXL, Register::C>,
+            /* DD 6A */ instr_ld<Register::IXL, Register::D>,
+            /* DD 6B */ instr_ld<Register::IXL, Register::E>,
+            /* DD 6C */ instr_ld<Register::IXL, Register::IXH>,
+            /* DD 6D */ instr_ld<Register::IXL, Register::IXL>,
+            /* DD 6E */ instr_ld<Register::L, AddressingMode::IXPlus>,
+            /* DD 6F */ instr_ld<Register::IXL, Register::A>,
+            /* DD 70 */ instr_ld<AddressingMode::IXPlus, Register::B>,
+            /* DD 71 */ instr_ld<AddressingMode::IXPlus, Register::C>,
+            /* DD 72 */ instr_ld<AddressingMode::IXPlus, Register::D>,
+            /* DD 73 */ instr_ld<AddressingMode::IXPlus, Register::E>,
+            /* DD 74 */ instr_ld<AddressingMode::IXPlus, Register::H>,
+            /* DD 75 */ instr_ld<AddressingMode::IXPlus, Register::L>,
+            /* DD 76 */ instructions<Bus>[0x76],
+            /* DD 77 */ instr_ld<AddressingMode::IXPlus, Register::A>,
+            /* DD 78 */ instructions<Bus>[0x78],
+            /* DD 79 */ instructions<Bus>[0x79],
+            /* DD 7A */ instructions<Bus>[0x7A],
+            /* DD 7B */ instructions<Bus>[0x7B],
+            /* DD 7C */ instr_ld<Register::A, Register::IXH>,
+            /* DD 7D */ instr_ld<Register::A, Register::IXL>,
+            /* DD 7E */ instr_ld<Register::A, AddressingMode::IXPlus>,
+            /* DD 7F */ instructions<Bus>[0x7F],
+            /* DD 80 */ instructions<Bus>[0x80],
+            /* DD 81 */ instructions<Bus>[0x81],
+            /* DD 82 */ instructions<Bus>[0x82],
+            /* DD 83 */ instructions<Bus>[0x83],
+            /* DD 84 */ instr_add<Register::A, Register::IXH>,
+            /* DD 85 */ instr_add<Register::A, Register::IXL>,
+            /* DD 86 */ instr_add<Register::A, AddressingMode::IXPlus>,
+            /* DD 87 */ instructions<Bus>[0x87],
+            /* DD 88 */ instructions<Bus>[0x88],
+            /* DD 89 */ instructions<Bus>[0x89],
+            /* DD 8A */ instructions<Bus>[0x8A],
+            /* DD 8B */ instructions<Bus>[0x8B],
+            /* DD 8C */ instr_adc<Register::A, Register::IXH>,
+            /* DD 8D */ instr_adc<Register::A, Register::IXL>,
+            /* DD 8E */ instr_adc<Register::A, AddressingMode::IXPlus>,
+            /* DD 8F */ instructions<Bus>[0x8F],
+            /* DD 90 */ instructions<Bus>[0x90],
+            /* DD 91 */ instructions<Bus>[0x91],
+            /* DD 92 */ instructions<Bus>[0x92],
+            /* DD 93 */ instructions<Bus>[0x93],
+            /* DD 94 */ instr_sub<Register::IXH>,
+            /* DD 95 */ instr_sub<Register::IXL>,
+            /* DD 96 */ instr_sub<AddressingMode::IXPlus>,
+            /* DD 97 */ instructions<Bus>[0x97],
+            /* DD 98 */ instructions<Bus>[0x98],
+            /* DD 99 */ instructions<Bus>[0x99],
+            /* DD 9A */ instructions<Bus>[0x9A],
+            /* DD 9B */ instructions<Bus>[0x9B],
+            /* DD 9C */ instr_sbc<Register::A, Register::IXH>,
+            /* DD 9D */ instr_sbc<Register::A, Register::IXL>,
+            /* DD 9E */ instr_sbc<Register::A, AddressingMode::IXPlus>,
+            /* DD 9F */ instructions<Bus>[0x9F],
+            /* DD A0 */ instructions<Bus>[0xA0],
+            /* DD A1 */ instructions<Bus>[0xA1],
+            /* DD A2 */ instructions<Bus>[0xA2],
+            /* DD A3 */ instructions<Bus>[0xA3],
+            /* DD A4 */ instr_and<Register::IXH>,
+            /* DD A5 */ instr_and<Register::IXL>,
+            /* DD A6 */ instr_and<AddressingMode::IXPlus>,
+            /* DD A7 */ instructions<Bus>[0xA7],
+            /* DD A8 */ instructions<Bus>[0xA8],
+            /* DD A9 */ instructions<Bus>[0xA9],
+            /* DD AA */ instructions<Bus>[0xAA],
+            /* DD AB */ instructions<Bus>[0xAB],
+            /* DD AC */ instr_xor<Register::IXH>,
+            /* DD AD */ instr_xor<Register::IXL>,
+            /* DD AE */ instr_xor<AddressingMode::IXPlus>,
+            /* DD AF */ instructions<Bus>[0xAF],
+            /* DD B0 */ instructions<Bus>[0xB0],
+            /* DD B1 */ instructions<Bus>[0xB1],
+            /* DD B2 */ instructions<Bus>[0xB2],
+            /* DD B3 */ instructions<Bus>[0xB3],
+            /* DD B4 */ instr_or<Register::IXH>,
+            /* DD B5 */ instr_or<Register::IXL>,
+            /* DD B6 */ instr_or<AddressingMode::IXPlus>,
+            /* DD B7 */ instructions<Bus>[0xB7],
+            /* DD B8 */ instructions<Bus>[0xB8],
+            /* DD B9 */ instructions<Bus>[0xB9],
+            /* DD BA */ instructions<Bus>[0xBA],
+            /* DD BB */ instructions<Bus>[0xBB],
+            /* DD BC */ instr_cp<Register::IXH>,
+            /* DD BD */ instr_cp<Register::IXL>,
+            /* DD BE */ instr_cp<AddressingMode::IXPlus>,
+            /* DD BF */ instructions<Bus>[0xBF],
+            /* DD C0 */ instructions<Bus>[0xC0],
+            /* DD C1 */ instructions<Bus>[0xC1],
+            /* DD C2 */ instructions<Bus>[0xC2],
+            /* DD C3 */ instructions<Bus>[0xC3],
+            /* DD C4 */ instructions<Bus>[0xC4],
+            /* DD C5 */ instructions<Bus>[0xC5],
+            /* DD C6 */ instructions<Bus>[0xC6],
+            /* DD C7 */ instructions<Bus>[0xC7],
+            /* DD C8 */ instructions<Bus>[0xC8],
+            /* DD C9 */ instructions<Bus>[0xC9],
+            /* DD CA */ instructions<Bus>[0xCA],
+            /* DD CB */ instr_ddcb,
+            /* DD CC */ instructions<Bus>[0xCC],
+            /* DD CD */ instructions<Bus>[0xCD],
+            /* DD CE */ instructions<Bus>[0xCE],
+            /* DD CF */ instructions<Bus>[0xCF],
+            /* DD D0 */ instructions<Bus>[0xD0],
+            /* DD D1 */ instructions<Bus>[0xD1],
+            /* DD D2 */ instructions<Bus>[0xD2],
+            /* DD D3 */ instructions<Bus>[0xD3],
+            /* DD D4 */ instructions<Bus>[0xD4],
+            /* DD D5 */ instructions<Bus>[0xD5],
+            /* DD D6 */ instructions<Bus>[0xD6],
+            /* DD D7 */ instructions<Bus>[0xD7],
+            /* DD D8 */ instructions<Bus>[0xD8],
+            /* DD D9 */ instructions<Bus>[0xD9],
+            /* DD DA */ instructions<Bus>[0xDA],
+            /* DD DB */ instructions<Bus>[0xDB],
+            /* DD DC */ instructions<Bus>[0xDC],
+            /* DD DD */ unimplemented_dd_instr<0xDD>,
+            /* DD DE */ instructions<Bus>[0xDE],
+            /* DD DF */ instructions<Bus>[0xDF],
+            /* DD E0 */ instructions<Bus>[0xE0],
+            /* DD E1 */ instr_pop<Register::IX>,
+            /* DD E2 */ instructions<Bus>[0xE2],
+            /* DD E3 */ unimplemented_dd_instr<0xE3>, // ex (sp), ix
+            /* DD E4 */ instructions<Bus>[0xE4],
+            /* DD E5 */ instr_push<Register::IX>,
+            /* DD E6 */ instructions<Bus>[0xE6],
+            /* DD E7 */ instructions<Bus>[0xE7],
+            /* DD E8 */ instructions<Bus>[0xE8],
+            /* DD E9 */ instr_jp<Condition::Always, AddressingMode::IX>,
+            /* DD EA */ instructions<Bus>[0xEA],
+            /* DD EB */ instructions<Bus>[0xEB],
+            /* DD EC */ instructions<Bus>[0xEC],
+            /* DD ED */ instructions<Bus>[0xED],
+            /* DD EE */ instructions<Bus>[0xEE],
+            /* DD EF */ instructions<Bus>[0xEF],
+            /* DD F0 */ instructions<Bus>[0xF0],
+            /* DD F1 */ instructions<Bus>[0xF1],
+            /* DD F2 */ instructions<Bus>[0xF2],
+            /* DD F3 */ instructions<Bus>[0xF3],
+            /* DD F4 */ instructions<Bus>[0xF4],
+            /* DD F5 */ instructions<Bus>[0xF5],
+            /* DD F6 */ instructions<Bus>[0xF6],
+            /* DD F7 */ instructions<Bus>[0xF7],
+            /* DD F8 */ instructions<Bus>[0xF8],
+            /* DD F9 */ instructions<Bus>[0xF9],
+            /* DD FA */ unimplemented_dd_instr<0xFA>,
+            /* DD FB */ instructions<Bus>[0xFB],
+            /* DD FC */ instructions<Bus>[0xFC],
+            /* DD FD */ instructions<Bus>[0xFD],
+            /* DD FE */ instructions<Bus>[0xFE],
+            /* DD FF */ instructions<Bus>[0xFF],
+    };
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> ddcb_instructions[0x100] = {
+            /* DD CB 00 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 01 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 02 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 03 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 04 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 05 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 06 */ instr_rlc<AddressingMode::IXPlusPrevious>,
+            /* DD CB 07 */ instr_rlc<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 08 */ instr_rrc<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 09 */ instr_rrc<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 0A */ instr_rrc<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 0B */ instr_rrc<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 0C */ instr_rrc<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 0D */ instr_rrc<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 0E */ instr_rrc<AddressingMode::IXPlusPrevious>,
+            /* DD CB 0F */ instr_rrc<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 10 */ instr_rl<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 11 */ instr_rl<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 12 */ instr_rl<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 13 */ instr_rl<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 14 */ instr_rl<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 15 */ instr_rl<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 16 */ instr_rl<AddressingMode::IXPlusPrevious>,
+            /* DD CB 17 */ instr_rl<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 18 */ instr_rr<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 19 */ instr_rr<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 1A */ instr_rr<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 1B */ instr_rr<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 1C */ instr_rr<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 1D */ instr_rr<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 1E */ instr_rr<AddressingMode::IXPlusPrevious>,
+            /* DD CB 1F */ instr_rr<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 20 */ instr_sla<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 21 */ instr_sla<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 22 */ instr_sla<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 23 */ instr_sla<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 24 */ instr_sla<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 25 */ instr_sla<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 26 */ instr_sla<AddressingMode::IXPlusPrevious>,
+            /* DD CB 27 */ instr_sla<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 28 */ instr_sra<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 29 */ instr_sra<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 2A */ instr_sra<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 2B */ instr_sra<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 2C */ instr_sra<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 2D */ instr_sra<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 2E */ instr_sra<AddressingMode::IXPlusPrevious>,
+            /* DD CB 2F */ instr_sra<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 30 */ instr_sll<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 31 */ instr_sll<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 32 */ instr_sll<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 33 */ instr_sll<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 34 */ instr_sll<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 35 */ instr_sll<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 36 */ instr_sll<AddressingMode::IXPlusPrevious>,
+            /* DD CB 37 */ instr_sll<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 38 */ instr_srl<AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 39 */ instr_srl<AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 3A */ instr_srl<AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 3B */ instr_srl<AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 3C */ instr_srl<AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 3D */ instr_srl<AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 3E */ instr_srl<AddressingMode::IXPlusPrevious>,
+            /* DD CB 3F */ instr_srl<AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 40 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 41 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 42 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 43 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 44 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 45 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 46 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 47 */ instr_bit<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 48 */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 49 */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 4A */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 4B */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 4C */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 4D */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 4E */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 4F */ instr_bit<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 50 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 51 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 52 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 53 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 54 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 55 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 56 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 57 */ instr_bit<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 58 */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 59 */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 5A */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 5B */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 5C */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 5D */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 5E */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 5F */ instr_bit<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 60 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 61 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 62 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 63 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 64 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 65 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 66 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 67 */ instr_bit<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB 68 */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 69 */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 6A */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 6B */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 6C */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 6D */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 6E */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 6F */ instr_bit<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB 70 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 71 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 72 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 73 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 74 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 75 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 76 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 77 */ instr_bit<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB 78 */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 79 */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 7A */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 7B */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 7C */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 7D */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 7E */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 7F */ instr_bit<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB 80 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 81 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 82 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 83 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 84 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 85 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 86 */ instr_res<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB 87 */ instr_res<0, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 88 */ instr_res<1, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 89 */ instr_res<1, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 8A */ instr_res<1, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 8B */ instr_res<1, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 8C */ instr_res<1, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 8D */ instr_res<1, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 8E */ instr_res<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB 8F */ instr_res<1, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 90 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 91 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 92 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 93 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 94 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 95 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 96 */ instr_res<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB 97 */ instr_res<2, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB 98 */ instr_res<3, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB 99 */ instr_res<3, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB 9A */ instr_res<3, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB 9B */ instr_res<3, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB 9C */ instr_res<3, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB 9D */ instr_res<3, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB 9E */ instr_res<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB 9F */ instr_res<3, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB A0 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB A1 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB A2 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB A3 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB A4 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB A5 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB A6 */ instr_res<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB A7 */ instr_res<4, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB A8 */ instr_res<5, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB A9 */ instr_res<5, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB AA */ instr_res<5, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB AB */ instr_res<5, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB AC */ instr_res<5, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB AD */ instr_res<5, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB AE */ instr_res<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB AF */ instr_res<5, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB B0 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB B1 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB B2 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB B3 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB B4 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB B5 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB B6 */ instr_res<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB B7 */ instr_res<6, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB B8 */ instr_res<7, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB B9 */ instr_res<7, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB BA */ instr_res<7, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB BB */ instr_res<7, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB BC */ instr_res<7, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB BD */ instr_res<7, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB BE */ instr_res<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB BF */ instr_res<7, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB C0 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB C1 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB C2 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB C3 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB C4 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB C5 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB C6 */ instr_set<0, AddressingMode::IXPlusPrevious>,
+            /* DD CB C7 */ instr_set<0, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB C8 */ instr_set<1, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB C9 */ instr_set<1, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB CA */ instr_set<1, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB CB */ instr_set<1, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB CC */ instr_set<1, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB CD */ instr_set<1, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB CE */ instr_set<1, AddressingMode::IXPlusPrevious>,
+            /* DD CB CF */ instr_set<1, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB D0 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB D1 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB D2 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB D3 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB D4 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB D5 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB D6 */ instr_set<2, AddressingMode::IXPlusPrevious>,
+            /* DD CB D7 */ instr_set<2, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB D8 */ instr_set<3, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB D9 */ instr_set<3, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB DA */ instr_set<3, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB DB */ instr_set<3, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB DC */ instr_set<3, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB DD */ instr_set<3, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB DE */ instr_set<3, AddressingMode::IXPlusPrevious>,
+            /* DD CB DF */ instr_set<3, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB E0 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB E1 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB E2 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB E3 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB E4 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB E5 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB E6 */ instr_set<4, AddressingMode::IXPlusPrevious>,
+            /* DD CB E7 */ instr_set<4, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB E8 */ instr_set<5, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB E9 */ instr_set<5, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB EA */ instr_set<5, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB EB */ instr_set<5, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB EC */ instr_set<5, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB ED */ instr_set<5, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB EE */ instr_set<5, AddressingMode::IXPlusPrevious>,
+            /* DD CB EF */ instr_set<5, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB F0 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB F1 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB F2 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB F3 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB F4 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB F5 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB F6 */ instr_set<6, AddressingMode::IXPlusPrevious>,
+            /* DD CB F7 */ instr_set<6, AddressingMode::IXPlusPrevious, Register::A>,
+            /* DD CB F8 */ instr_set<7, AddressingMode::IXPlusPrevious, Register::B>,
+            /* DD CB F9 */ instr_set<7, AddressingMode::IXPlusPrevious, Register::C>,
+            /* DD CB FA */ instr_set<7, AddressingMode::IXPlusPrevious, Register::D>,
+            /* DD CB FB */ instr_set<7, AddressingMode::IXPlusPrevious, Register::E>,
+            /* DD CB FC */ instr_set<7, AddressingMode::IXPlusPrevious, Register::H>,
+            /* DD CB FD */ instr_set<7, AddressingMode::IXPlusPrevious, Register::L>,
+            /* DD CB FE */ instr_set<7, AddressingMode::IXPlusPrevious>,
+            /* DD CB FF */ instr_set<7, AddressingMode::IXPlusPrevious, Register::A>
+    };
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> ed_instructions[0xC0] = {
+            /* ED 00 */ unimplemented_ed_instr<0x00>,
+            /* ED 01 */ unimplemented_ed_instr<0x01>,
+            /* ED 02 */ unimplemented_ed_instr<0x02>,
+            /* ED 03 */ unimplemented_ed_instr<0x03>,
+            /* ED 04 */ unimplemented_ed_instr<0x04>,
+            /* ED 05 */ unimplemented_ed_instr<0x05>,
+            /* ED 06 */ unimplemented_ed_instr<0x06>,
+            /* ED 07 */ unimplemented_ed_instr<0x07>,
+            /* ED 08 */ unimplemented_ed_instr<0x08>,
+            /* ED 09 */ unimplemented_ed_instr<0x09>,
+            /* ED 0A */ unimplemented_ed_instr<0x0A>,
+            /* ED 0B */ unimplemented_ed_instr<0x0B>,
+            /* ED 0C */ unimplemented_ed_instr<0x0C>,
+            /* ED 0D */ unimplemented_ed_instr<0x0D>,
+            /* ED 0E */ unimplemented_ed_instr<0x0E>,
+            /* ED 0F */ unimplemented_ed_instr<0x0F>,
+            /* ED 10 */ unimplemented_ed_instr<0x10>,
+            /* ED 11 */ unimplemented_ed_instr<0x11>,
+            /* ED 12 */ unimplemented_ed_instr<0x12>,
+            /* ED 13 */ unimplemented_ed_instr<0x13>,
+            /* ED 14 */ unimplemented_ed_instr<0x14>,
+            /* ED 15 */ unimplemented_ed_instr<0x15>,
+            /* ED 16 */ unimplemented_ed_instr<0x16>,
+            /* ED 17 */ unimplemented_ed_instr<0x17>,
+            /* ED 18 */ unimplemented_ed_instr<0x18>,
+            /* ED 19 */ unimplemented_ed_instr<0x19>,
+            /* ED 1A */ unimplemented_ed_instr<0x1A>,
+            /* ED 1B */ unimplemented_ed_instr<0x1B>,
+            /* ED 1C */ unimplemented_ed_instr<0x1C>,
+            /* ED 1D */ unimplemented_ed_instr<0x1D>,
+            /* ED 1E */ unimplemented_ed_instr<0x1E>,
+            /* ED 1F */ unimplemented_ed_instr<0x1F>,
+            /* ED 20 */ unimplemented_ed_instr<0x20>,
+            /* ED 21 */ unimplemented_ed_instr<0x21>,
+            /* ED 22 */ unimplemented_ed_instr<0x22>,
+            /* ED 23 */ unimplemented_ed_instr<0x23>,
+            /* ED 24 */ unimplemented_ed_instr<0x24>,
+            /* ED 25 */ unimplemented_ed_instr<0x25>,
+            /* ED 26 */ unimplemented_ed_instr<0x26>,
+            /* ED 27 */ unimplemented_ed_instr<0x27>,
+            /* ED 28 */ unimplemented_ed_instr<0x28>,
+            /* ED 29 */ unimplemented_ed_instr<0x29>,
+            /* ED 2A */ unimplemented_ed_instr<0x2A>,
+            /* ED 2B */ unimplemented_ed_instr<0x2B>,
+            /* ED 2C */ unimplemented_ed_instr<0x2C>,
+            /* ED 2D */ unimplemented_ed_instr<0x2D>,
+            /* ED 2E */ unimplemented_ed_instr<0x2E>,
+            /* ED 2F */ unimplemented_ed_instr<0x2F>,
+            /* ED 30 */ unimplemented_ed_instr<0x30>,
+            /* ED 31 */ unimplemented_ed_instr<0x31>,
+            /* ED 32 */ unimplemented_ed_instr<0x32>,
+            /* ED 33 */ unimplemented_ed_instr<0x33>,
+            /* ED 34 */ unimplemented_ed_instr<0x34>,
+            /* ED 35 */ unimplemented_ed_instr<0x35>,
+            /* ED 36 */ unimplemented_ed_instr<0x36>,
+            /* ED 37 */ unimplemented_ed_instr<0x37>,
+            /* ED 38 */ unimplemented_ed_instr<0x38>,
+            /* ED 39 */ unimplemented_ed_instr<0x39>,
+            /* ED 3A */ unimplemented_ed_instr<0x3A>,
+            /* ED 3B */ unimplemented_ed_instr<0x3B>,
+            /* ED 3C */ unimplemented_ed_instr<0x3C>,
+            /* ED 3D */ unimplemented_ed_instr<0x3D>,
+            /* ED 3E */ unimplemented_ed_instr<0x3E>,
+            /* ED 3F */ unimplemented_ed_instr<0x3F>,
+            /* ED 40 */ unimplemented_ed_instr<0x40>,
+            /* ED 41 */ unimplemented_ed_instr<0x41>,
+            /* ED 42 */ instr_sbc<Register::HL, Register::BC>,
+            /* ED 43 */ instr_ld<AddressingMode::Indirect, Register::BC>,
+            /* ED 44 */ instr_neg,
+            /* ED 45 */ unimplemented_ed_instr<0x45>,
+            /* ED 46 */ unimplemented_ed_instr<0x46>,
+            /* ED 47 */ instr_ld<Register::I, Register::A>,
+            /* ED 48 */ unimplemented_ed_instr<0x48>,
+            /* ED 49 */ unimplemented_ed_instr<0x49>,
+            /* ED 4A */ instr_adc<Register::HL, Register::BC>,
+            /* ED 4B */ instr_ld<Register::BC, AddressingMode::Indirect>,
+            /* ED 4C */ unimplemented_ed_instr<0x4C>,
+            /* ED 4D */ unimplemented_ed_instr<0x4D>,
+            /* ED 4E */ unimplemented_ed_instr<0x4E>,
+            /* ED 4F */ instr_ld<Register::R, Register::A>,
+            /* ED 50 */ unimplemented_ed_instr<0x50>,
+            /* ED 51 */ instr_out<Register::C, Register::D>,
+            /* ED 52 */ instr_sbc<Register::HL, Register::DE>,
+            /* ED 53 */ instr_ld<AddressingMode::Indirect, Register::DE>,
+            /* ED 54 */ unimplemented_ed_instr<0x54>,
+            /* ED 55 */ unimplemented_ed_instr<0x55>,
+            /* ED 56 */ instr_im_1,
+            /* ED 57 */ instr_ld<Register::A, Register::I>,
+            /* ED 58 */ unimplemented_ed_instr<0x58>,
+            /* ED 59 */ unimplemented_ed_instr<0x59>,
+            /* ED 5A */ instr_adc<Register::HL, Register::DE>,
+            /* ED 5B */ instr_ld<Register::DE, AddressingMode::Indirect>,
+            /* ED 5C */ unimplemented_ed_instr<0x5C>,
+            /* ED 5D */ unimplemented_ed_instr<0x5D>,
+            /* ED 5E */ unimplemented_ed_instr<0x5E>,
+            /* ED 5F */ instr_ld<Register::A, Register::R>,
+            /* ED 60 */ unimplemented_ed_instr<0x60>,
+            /* ED 61 */ unimplemented_ed_instr<0x61>,
+            /* ED 62 */ instr_sbc<Register::HL, Register::HL>,
+            /* ED 63 */ instr_ld<AddressingMode::Indirect, Register::H>,
+            /* ED 64 */ unimplemented_ed_instr<0x64>,
+            /* ED 65 */ unimplemented_ed_instr<0x65>,
+            /* ED 66 */ unimplemented_ed_instr<0x66>,
+            /* ED 67 */ instr_rrd,
+            /* ED 68 */ unimplemented_ed_instr<0x68>,
+            /* ED 69 */ unimplemented_ed_instr<0x69>,
+            /* ED 6A */ instr_adc<Register::HL, Register::HL>,
+            /* ED 6B */ instr_ld<Register::HL, AddressingMode::Indirect>,
+            /* ED 6C */ unimplemented_ed_instr<0x6C>,
+            /* ED 6D */ unimplemented_ed_instr<0x6D>,
+            /* ED 6E */ unimplemented_ed_instr<0x6E>,
+            /* ED 6F */ instr_rld,
+            /* ED 70 */ unimplemented_ed_instr<0x70>,
+            /* ED 71 */ unimplemented_ed_instr<0x71>,
+            /* ED 72 */ instr_sbc<Register::HL, Register::SP>,
+            /* ED 73 */ instr_ld<AddressingMode::Indirect, Register::SP>,
+            /* ED 74 */ unimplemented_ed_instr<0x74>,
+            /* ED 75 */ unimplemented_ed_instr<0x75>,
+            /* ED 76 */ unimplemented_ed_instr<0x76>,
+            /* ED 77 */ unimplemented_ed_instr<0x77>,
+            /* ED 78 */ unimplemented_ed_instr<0x78>,
+            /* ED 79 */ instr_out<Register::C, Register::A>,
+            /* ED 7A */ instr_adc<Register::HL, Register::SP>,
+            /* ED 7B */ instr_ld<Register::SP, AddressingMode::Indirect>,
+            /* ED 7C */ unimplemented_ed_instr<0x7C>,
+            /* ED 7D */ unimplemented_ed_instr<0x7D>,
+            /* ED 7E */ unimplemented_ed_instr<0x7E>,
+            /* ED 7F */ unimplemented_ed_instr<0x7F>,
+            /* ED 80 */ unimplemented_ed_instr<0x80>,
+            /* ED 81 */ unimplemented_ed_instr<0x81>,
+            /* ED 82 */ unimplemented_ed_instr<0x82>,
+            /* ED 83 */ unimplemented_ed_instr<0x83>,
+            /* ED 84 */ unimplemented_ed_instr<0x84>,
+            /* ED 85 */ unimplemented_ed_instr<0x85>,
+            /* ED 86 */ unimplemented_ed_instr<0x86>,
+            /* ED 87 */ unimplemented_ed_instr<0x87>,
+            /* ED 88 */ unimplemented_ed_instr<0x88>,
+            /* ED 89 */ unimplemented_ed_instr<0x89>,
+            /* ED 8A */ unimplemented_ed_instr<0x8A>,
+            /* ED 8B */ unimplemented_ed_instr<0x8B>,
+            /* ED 8C */ unimplemented_ed_instr<0x8C>,
+            /* ED 8D */ unimplemented_ed_instr<0x8D>,
+            /* ED 8E */ unimplemented_ed_instr<0x8E>,
+            /* ED 8F */ unimplemented_ed_instr<0x8F>,
+            /* ED 90 */ unimplemented_ed_instr<0x90>,
+            /* ED 91 */ unimplemented_ed_instr<0x91>,
+            /* ED 92 */ unimplemented_ed_instr<0x92>,
+            /* ED 93 */ unimplemented_ed_instr<0x93>,
+            /* ED 94 */ unimplemented_ed_instr<0x94>,
+            /* ED 95 */ unimplemented_ed_instr<0x95>,
+            /* ED 96 */ unimplemented_ed_instr<0x96>,
+            /* ED 97 */ unimplemented_ed_instr<0x97>,
+            /* ED 98 */ unimplemented_ed_instr<0x98>,
+            /* ED 99 */ unimplemented_ed_instr<0x99>,
+            /* ED 9A */ unimplemented_ed_instr<0x9A>,
+            /* ED 9B */ unimplemented_ed_instr<0x9B>,
+            /* ED 9C */ unimplemented_ed_instr<0x9C>,
+            /* ED 9D */ unimplemented_ed_instr<0x9D>,
+            /* ED 9E */ unimplemented_ed_instr<0x9E>,
+            /* ED 9F */ unimplemented_ed_instr<0x9F>,
+            /* ED A0 */ instr_ldi,
+            /* ED A1 */ instr_cpd_cpi<1>,
+            /* ED A2 */ unimplemented_ed_instr<0xA2>,
+            /* ED A3 */ instr_outi,
+            /* ED A4 */ unimplemented_ed_instr<0xA4>,
+            /* ED A5 */ unimplemented_ed_instr<0xA5>,
+            /* ED A6 */ unimplemented_ed_instr<0xA6>,
+            /* ED A7 */ unimplemented_ed_instr<0xA7>,
+            /* ED A8 */ instr_ldd,
+            /* ED A9 */ instr_cpd_cpi<-1>,
+            /* ED AA */ unimplemented_ed_instr<0xAA>,
+            /* ED AB */ unimplemented_ed_instr<0xAB>,
+            /* ED AC */ unimplemented_ed_instr<0xAC>,
+            /* ED AD */ unimplemented_ed_instr<0xAD>,
+            /* ED AE */ unimplemented_ed_instr<0xAE>,
+            /* ED AF */ unimplemented_ed_instr<0xAF>,
+            /* ED B0 */ instr_lddr_ldir<1>,
+            /* ED B1 */ instr_cpdr_cpir<1>,
+            /* ED B2 */ unimplemented_ed_instr<0xB2>,
+            /* ED B3 */ instr_otir,
+            /* ED B4 */ unimplemented_ed_instr<0xB4>,
+            /* ED B5 */ unimplemented_ed_instr<0xB5>,
+            /* ED B6 */ unimplemented_ed_instr<0xB6>,
+            /* ED B7 */ unimplemented_ed_instr<0xB7>,
+            /* ED B8 */ instr_lddr_ldir<-1>,
+            /* ED B9 */ instr_cpdr_cpir<-1>,
+            /* ED BA */ unimplemented_ed_instr<0xBA>,
+            /* ED BB */ unimplemented_ed_instr<0xBB>,
+            /* ED BC */ unimplemented_ed_instr<0xBC>,
+            /* ED BD */ unimplemented_ed_instr<0xBD>,
+            /* ED BE */ unimplemented_ed_instr<0xBE>,
+            /* ED BF */ unimplemented_ed_instr<0xBF>,
+    };
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> fd_instructions[0x100] = {
+            /* FD 00 */ instructions<Bus>[0x00],
+            /* FD 01 */ instructions<Bus>[0x01],
+            /* FD 02 */ instructions<Bus>[0x02],
+            /* FD 03 */ instructions<Bus>[0x03],
+            /* FD 04 */ instructions<Bus>[0x04],
+            /* FD 05 */ instructions<Bus>[0x05],
+            /* FD 06 */ instructions<Bus>[0x06],
+            /* FD 07 */ instructions<Bus>[0x07],
+            /* FD 08 */ instructions<Bus>[0x08],
+            /* FD 09 */ instr_add<Register::IY, Register::BC>,
+            /* FD 0A */ instructions<Bus>[0x0A],
+            /* FD 0B */ instructions<Bus>[0x0B],
+            /* FD 0C */ instructions<Bus>[0x0C],
+            /* FD 0D */ instructions<Bus>[0x0D],
+            /* FD 0E */ instructions<Bus>[0x0E],
+            /* FD 0F */ instructions<Bus>[0x0F],
+            /* FD 10 */ instructions<Bus>[0x10],
+            /* FD 11 */ instructions<Bus>[0x11],
+            /* FD 12 */ instructions<Bus>[0x12],
+            /* FD 13 */ instructions<Bus>[0x13],
+            /* FD 14 */ instructions<Bus>[0x14],
+            /* FD 15 */ instructions<Bus>[0x15],
+            /* FD 16 */ instructions<Bus>[0x16],
+            /* FD 17 */ instructions<Bus>[0x17],
+            /* FD 18 */ instructions<Bus>[0x18],
+            /* FD 19 */ instr_add<Register::IY, Register::DE>,
+            /* FD 1A */ instructions<Bus>[0x1A],
+            /* FD 1B */ instructions<Bus>[0x1B],
+            /* FD 1C */ instructions<Bus>[0x1C],
+            /* FD 1D */ instructions<Bus>[0x1D],
+            /* FD 1E */ instructions<Bus>[0x1E],
+            /* FD 1F */ instructions<Bus>[0x1F],
+            /* FD 20 */ instructions<Bus>[0x20],
+            /* FD 21 */ instr_ld<Register::IY, AddressingMode::Immediate>,
+            /* FD 22 */ instr_ld<AddressingMode::Indirect, Register::IY>,
+            /* FD 23 */ instr_inc<Register::IY>,
+            /* FD 24 */ instr_inc<Register::IYH>,
+            /* FD 25 */ instr_dec<Register::IYH>,
+            /* FD 26 */ instr_ld<Register::IYH, AddressingMode::Immediate>,
+            /* FD 27 */ instructions<Bus>[0x27],
+            /* FD 28 */ instructions<Bus>[0x28],
+            /* FD 29 */ instr_add<Register::IY, Register::IY>,
+            /* FD 2A */ instr_ld<Register::IY, AddressingMode::Indirect>,
+            /* FD 2B */ instr_dec<Register::IY>,
+            /* FD 2C */ instr_inc<Register::IYL>,
+            /* FD 2D */ instr_dec<Register::IYL>,
+            /* FD 2E */ instr_ld<Register::IYL, AddressingMode::Immediate>,
+            /* FD 2F */ instructions<Bus>[0x2F],
+            /* FD 30 */ instructions<Bus>[0x30],
+            /* FD 31 */ instructions<Bus>[0x31],
+            /* FD 32 */ instructions<Bus>[0x32],
+            /* FD 33 */ instructions<Bus>[0x33],
+            /* FD 34 */ instr_inc<AddressingMode::IYPlus>,
+            /* FD 35 */ instr_dec<AddressingMode::IYPlus>,
+            /* FD 36 */ instr_ld<AddressingMode::IYPlus, AddressingMode::Immediate>,
+            /* FD 37 */ instructions<Bus>[0x37],
+            /* FD 38 */ instructions<Bus>[0x38],
+            /* FD 39 */ instr_add<Register::IY, Register::SP>,
+            /* FD 3A */ instructions<Bus>[0x3A],
+            /* FD 3B */ instructions<Bus>[0x3B],
+            /* FD 3C */ instructions<Bus>[0x3C],
+            /* FD 3D */ instructions<Bus>[0x3D],
+            /* FD 3E */ instructions<Bus>[0x3E],
+            /* FD 3F */ instructions<Bus>[0x3F],
+            /* FD 40 */ instructions<Bus>[0x40],
+            /* FD 41 */ instructions<Bus>[0x41],
+            /* FD 42 */ instructions<Bus>[0x42],
+            /* FD 43 */ instructions<Bus>[0x43],
+            /* FD 44 */ instr_ld<Register::B, Register::IYH>,
+            /* FD 45 */ instr_ld<Register::B, Register::IYL>,
+            /* FD 46 */ instr_ld<Register::B, AddressingMode::IYPlus>,
+            /* FD 47 */ instructions<Bus>[0x47],
+            /* FD 48 */ instructions<Bus>[0x48],
+            /* FD 49 */ instructions<Bus>[0x49],
+            /* FD 4A */ instructions<Bus>[0x4A],
+            /* FD 4B */ instructions<Bus>[0x4B],
+            /* FD 4C */ instr_ld<Register::C, Register::IYH>,
+            /* FD 4D */ instr_ld<Register::C, Register::IYL>,
+            /* FD 4E */ instr_ld<Register::C, AddressingMode::IYPlus>,
+            /* FD 4F */ instructions<Bus>[0x4F],
+            /* FD 50 */ instructions<Bus>[0x50],
+            /* FD 51 */ instructions<Bus>[0x51],
+            /* FD 52 */ instructions<Bus>[0x52],
+            /* FD 53 */ instructions<Bus>[0x53],
+            /* FD 54 */ instr_ld<Register::D, Register::IYH>,
+            /* FD 55 */ instr_ld<Register::D, Register::IYL>,
+            /* FD 56 */ instr_ld<Register::D, AddressingMode::IYPlus>,
+            /* FD 57 */ instructions<Bus>[0x57],
+            /* FD 58 */ instructions<Bus>[0x58],
+            /* FD 59 */ instructions<Bus>[0x59],
+            /* FD 5A */ instructions<Bus>[0x5A],
+            /* FD 5B */ instructions<Bus>[0x5B],
+            /* FD 5C */ instr_ld<Register::E, Register::IYH>,
+            /* FD 5D */ instr_ld<Register::E, Register::IYL>,
+            /* FD 5E */ instr_ld<Register::E, AddressingMode::IYPlus>,
+            /* FD 5F */ instructions<Bus>[0x5F],
+            /* FD 60 */ instr_ld<Register::IYH, Register::B>,
+            /* FD 61 */ instr_ld<Register::IYH, Register::C>,
+            /* FD 62 */ instr_ld<Register::IYH, Register::D>,
+            /* FD 63 */ instr_ld<Register::IYH, Register::E>,
+            /* FD 64 */ instr_ld<Register::IYH, Register::IYH>,
+            /* FD 65 */ instr_ld<Register::IYH, Register::IYL>,
+            /* FD 66 */ instr_ld<Register::H, AddressingMode::IYPlus>,
+            /* FD 67 */ instr_ld<Register::IYH, Register::A>,
+            /* FD 68 */ instr_ld<Register::IYL, Register::B>,
+            /* FD 69 */ instr_ld<Register::IYL, Register::C>,
+            /* FD 6A */ instr_ld<Register::IYL, Register::D>,
+            /* FD 6B */ instr_ld<Register::IYL, Register::E>,
+            /* FD 6C */ instr_ld<Register::IYL, Register::IYH>,
+            /* FD 6D */ instr_ld<Register::IYL, Register::IYL>,
+            /* FD 6E */ instr_ld<Register::L, AddressingMode::IYPlus>,
+            /* FD 6F */ instr_ld<Register::IYL, Register::A>,
+            /* FD 70 */ instr_ld<AddressingMode::IYPlus, Register::B>,
+            /* FD 71 */ instr_ld<AddressingMode::IYPlus, Register::C>,
+            /* FD 72 */ instr_ld<AddressingMode::IYPlus, Register::D>,
+            /* FD 73 */ instr_ld<AddressingMode::IYPlus, Register::E>,
+            /* FD 74 */ instr_ld<AddressingMode::IYPlus, Register::H>,
+            /* FD 75 */ instr_ld<AddressingMode::IYPlus, Register::L>,
+            /* FD 76 */ instructions<Bus>[0x76],
+            /* FD 77 */ instr_ld<AddressingMode::IYPlus, Register::A>,
+            /* FD 78 */ instructions<Bus>[0x78],
+            /* FD 79 */ instructions<Bus>[0x79],
+            /* FD 7A */ instructions<Bus>[0x7A],
+            /* FD 7B */ instructions<Bus>[0x7B],
+            /* FD 7C */ instr_ld<Register::A, Register::IYH>,
+            /* FD 7D */ instr_ld<Register::A, Register::IYL>,
+            /* FD 7E */ instr_ld<Register::A, AddressingMode::IYPlus>,
+            /* FD 7F */ instructions<Bus>[0x7F],
+            /* FD 80 */ instructions<Bus>[0x80],
+            /* FD 81 */ instructions<Bus>[0x81],
+            /* FD 82 */ instructions<Bus>[0x82],
+            /* FD 83 */ instructions<Bus>[0x83],
+            /* FD 84 */ instr_add<Register::A, Register::IYH>,
+            /* FD 85 */ instr_add<Register::A, Register::IYL>,
+            /* FD 86 */ instr_add<Register::A, AddressingMode::IYPlus>,
+            /* FD 87 */ instructions<Bus>[0x87],
+            /* FD 88 */ instructions<Bus>[0x88],
+            /* FD 89 */ instructions<Bus>[0x89],
+            /* FD 8A */ instructions<Bus>[0x8A],
+            /* FD 8B */ instructions<Bus>[0x8B],
+            /* FD 8C */ instr_adc<Register::A, Register::IYH>,
+            /* FD 8D */ instr_adc<Register::A, Register::IYL>,
+            /* FD 8E */ instr_adc<Register::A, AddressingMode::IYPlus>,
+            /* FD 8F */ instructions<Bus>[0x8F],
+            /* FD 90 */ instructions<Bus>[0x90],
+            /* FD 91 */ instructions<Bus>[0x91],
+            /* FD 92 */ instructions<Bus>[0x92],
+            /* FD 93 */ instructions<Bus>[0x93],
+            /* FD 94 */ instr_sub<Register::IYH>,
+            /* FD 95 */ instr_sub<Register::IYL>,
+            /* FD 96 */ instr_sub<AddressingMode::IYPlus>,
+            /* FD 97 */ instructions<Bus>[0x97],
+            /* FD 98 */ instructions<Bus>[0x98],
+            /* FD 99 */ instructions<Bus>[0x99],
+            /* FD 9A */ instructions<Bus>[0x9A],
+            /* FD 9B */ instructions<Bus>[0x9B],
+            /* FD 9C */ instr_sbc<Register::A, Register::IYH>,
+            /* FD 9D */ instr_sbc<Register::A, Register::IYL>,
+            /* FD 9E */ instr_sbc<Register::A, AddressingMode::IYPlus>,
+            /* FD 9F */ instructions<Bus>[0x9F],
+            /* FD A0 */ instructions<Bus>[0xA0],
+            /* FD A1 */ instructions<Bus>[0xA1],
+            /* FD A2 */ instructions<Bus>[0xA2],
+            /* FD A3 */ instructions<Bus>[0xA3],
+            /* FD A4 */ instr_and<Register::IYH>,
+            /* FD A5 */ instr_and<Register::IYL>,
+            /* FD A6 */ instr_and<AddressingMode::IYPlus>,
+            /* FD A7 */ instructions<Bus>[0xA7],
+            /* FD A8 */ instructions<Bus>[0xA8],
+            /* FD A9 */ instructions<Bus>[0xA9],
+            /* FD AA */ instructions<Bus>[0xAA],
+            /* FD AB */ instructions<Bus>[0xAB],
+            /* FD AC */ instr_xor<Register::IYH>,
+            /* FD AD */ instr_xor<Register::IYL>,
+            /* FD AE */ instr_xor<AddressingMode::IYPlus>,
+            /* FD AF */ instructions<Bus>[0xAF],
+            /* FD B0 */ instructions<Bus>[0xB0],
+            /* FD B1 */ instructions<Bus>[0xB1],
+            /* FD B2 */ instructions<Bus>[0xB2],
+            /* FD B3 */ instructions<Bus>[0xB3],
+            /* FD B4 */ instr_or<Register::IYH>,
+            /* FD B5 */ instr_or<Register::IYL>,
+            /* FD B6 */ instr_or<AddressingMode::IYPlus>,
+            /* FD B7 */ instructions<Bus>[0xB7],
+            /* FD B8 */ instructions<Bus>[0xB8],
+            /* FD B9 */ instructions<Bus>[0xB9],
+            /* FD BA */ instructions<Bus>[0xBA],
+            /* FD BB */ instructions<Bus>[0xBB],
+            /* FD BC */ instr_cp<Register::IYH>,
+            /* FD BD */ instr_cp<Register::IYL>,
+            /* FD BE */ instr_cp<AddressingMode::IYPlus>,
+            /* FD BF */ instructions<Bus>[0xBF],
+            /* FD C0 */ instructions<Bus>[0xC0],
+            /* FD C1 */ instructions<Bus>[0xC1],
+            /* FD C2 */ instructions<Bus>[0xC2],
+            /* FD C3 */ instructions<Bus>[0xC3],
+            /* FD C4 */ instructions<Bus>[0xC4],
+            /* FD C5 */ instructions<Bus>[0xC5],
+            /* FD C6 */ instructions<Bus>[0xC6],
+            /* FD C7 */ instructions<Bus>[0xC7],
+            /* FD C8 */ instructions<Bus>[0xC8],
+            /* FD C9 */ instructions<Bus>[0xC9],
+            /* FD CA */ instructions<Bus>[0xCA],
+            /* FD CB */ instr_fdcb,
+            /* FD CC */ instructions<Bus>[0xCC],
+            /* FD CD */ instructions<Bus>[0xCD],
+            /* FD CE */ instructions<Bus>[0xCE],
+            /* FD CF */ instructions<Bus>[0xCF],
+            /* FD D0 */ instructions<Bus>[0xD0],
+            /* FD D1 */ instructions<Bus>[0xD1],
+            /* FD D2 */ instructions<Bus>[0xD2],
+            /* FD D3 */ instructions<Bus>[0xD3],
+            /* FD D4 */ instructions<Bus>[0xD4],
+            /* FD D5 */ instructions<Bus>[0xD5],
+            /* FD D6 */ instructions<Bus>[0xD6],
+            /* FD D7 */ instructions<Bus>[0xD7],
+            /* FD D8 */ instructions<Bus>[0xD8],
+            /* FD D9 */ instructions<Bus>[0xD9],
+            /* FD DA */ instructions<Bus>[0xDA],
+            /* FD DB */ instructions<Bus>[0xDB],
+            /* FD DC */ instructions<Bus>[0xDC],
+            /* FD DD */ unimplemented_fd_instr<0xDD>, // This is probably actually valid, but FD DD xx would be strange to see
+            /* FD DE */ instructions<Bus>[0xDE],
+            /* FD DF */ instructions<Bus>[0xDF],
+            /* FD E0 */ instructions<Bus>[0xE0],
+            /* FD E1 */ instr_pop<Register::IY>,
+            /* FD E2 */ instructions<Bus>[0xE2],
+            /* FD E3 */ unimplemented_fd_instr<0xE3>, // ex (sp), iy
+            /* FD E4 */ instructions<Bus>[0xE4],
+            /* FD E5 */ instr_push<Register::IY>,
+            /* FD E6 */ instructions<Bus>[0xE6],
+            /* FD E7 */ instructions<Bus>[0xE7],
+            /* FD E8 */ instructions<Bus>[0xE8],
+            /* FD E9 */ instr_jp<Condition::Always, AddressingMode::IY>,
+            /* FD EA */ instructions<Bus>[0xEA],
+            /* FD EB */ instructions<Bus>[0xEB],
+            /* FD EC */ instructions<Bus>[0xEC],
+            /* FD ED */ instructions<Bus>[0xED],
+            /* FD EE */ instructions<Bus>[0xEE],
+            /* FD EF */ instructions<Bus>[0xEF],
+            /* FD F0 */ instructions<Bus>[0xF0],
+            /* FD F1 */ instructions<Bus>[0xF1],
+            /* FD F2 */ instructions<Bus>[0xF2],
+            /* FD F3 */ instructions<Bus>[0xF3],
+            /* FD F4 */ instructions<Bus>[0xF4],
+            /* FD F5 */ instructions<Bus>[0xF5],
+            /* FD F6 */ instructions<Bus>[0xF6],
+            /* FD F7 */ instructions<Bus>[0xF7],
+            /* FD F8 */ instructions<Bus>[0xF8],
+            /* FD F9 */ instructions<Bus>[0xF9],
+            /* FD FA */ unimplemented_fd_instr<0xFA>,
+            /* FD FB */ instructions<Bus>[0xFB],
+            /* FD FC */ instructions<Bus>[0xFC],
+            /* FD FD */ unimplemented_fd_instr<0xFD>, // This is also probably valid, FD FD xx would be strange, and could be chained infinitely
+            /* FD FE */ instructions<Bus>[0xFE],
+            /* FD FF */ instructions<Bus>[0xFF],
+    };
+
+    template <typename Bus>
+    inline constexpr instruction<Bus> fdcb_instructions[0x100] = {
+            /* FD CB 00 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 01 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 02 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 03 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 04 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 05 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 06 */ instr_rlc<AddressingMode::IYPlusPrevious>,
+            /* FD CB 07 */ instr_rlc<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 08 */ instr_rrc<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 09 */ instr_rrc<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 0A */ instr_rrc<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 0B */ instr_rrc<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 0C */ instr_rrc<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 0D */ instr_rrc<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 0E */ instr_rrc<AddressingMode::IYPlusPrevious>,
+            /* FD CB 0F */ instr_rrc<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 10 */ instr_rl<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 11 */ instr_rl<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 12 */ instr_rl<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 13 */ instr_rl<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 14 */ instr_rl<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 15 */ instr_rl<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 16 */ instr_rl<AddressingMode::IYPlusPrevious>,
+            /* FD CB 17 */ instr_rl<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 18 */ instr_rr<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 19 */ instr_rr<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 1A */ instr_rr<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 1B */ instr_rr<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 1C */ instr_rr<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 1D */ instr_rr<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 1E */ instr_rr<AddressingMode::IYPlusPrevious>,
+            /* FD CB 1F */ instr_rr<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 20 */ instr_sla<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 21 */ instr_sla<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 22 */ instr_sla<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 23 */ instr_sla<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 24 */ instr_sla<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 25 */ instr_sla<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 26 */ instr_sla<AddressingMode::IYPlusPrevious>,
+            /* FD CB 27 */ instr_sla<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 28 */ instr_sra<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 29 */ instr_sra<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 2A */ instr_sra<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 2B */ instr_sra<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 2C */ instr_sra<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 2D */ instr_sra<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 2E */ instr_sra<AddressingMode::IYPlusPrevious>,
+            /* FD CB 2F */ instr_sra<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 30 */ instr_sll<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 31 */ instr_sll<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 32 */ instr_sll<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 33 */ instr_sll<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 34 */ instr_sll<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 35 */ instr_sll<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 36 */ instr_sll<AddressingMode::IYPlusPrevious>,
+            /* FD CB 37 */ instr_sll<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 38 */ instr_srl<AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 39 */ instr_srl<AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 3A */ instr_srl<AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 3B */ instr_srl<AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 3C */ instr_srl<AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 3D */ instr_srl<AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 3E */ instr_srl<AddressingMode::IYPlusPrevious>,
+            /* FD CB 3F */ instr_srl<AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 40 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 41 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 42 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 43 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 44 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 45 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 46 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 47 */ instr_bit<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 48 */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 49 */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 4A */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 4B */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 4C */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 4D */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 4E */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 4F */ instr_bit<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 50 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 51 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 52 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 53 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 54 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 55 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 56 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 57 */ instr_bit<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 58 */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 59 */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 5A */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 5B */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 5C */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 5D */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 5E */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 5F */ instr_bit<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 60 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 61 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 62 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 63 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 64 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 65 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 66 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 67 */ instr_bit<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB 68 */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 69 */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 6A */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 6B */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 6C */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 6D */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 6E */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 6F */ instr_bit<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB 70 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 71 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 72 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 73 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 74 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 75 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 76 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 77 */ instr_bit<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB 78 */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 79 */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 7A */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 7B */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 7C */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 7D */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 7E */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 7F */ instr_bit<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB 80 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 81 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 82 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 83 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 84 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 85 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 86 */ instr_res<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB 87 */ instr_res<0, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 88 */ instr_res<1, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 89 */ instr_res<1, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 8A */ instr_res<1, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 8B */ instr_res<1, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 8C */ instr_res<1, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 8D */ instr_res<1, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 8E */ instr_res<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB 8F */ instr_res<1, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 90 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 91 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 92 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 93 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 94 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 95 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 96 */ instr_res<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB 97 */ instr_res<2, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB 98 */ instr_res<3, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB 99 */ instr_res<3, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB 9A */ instr_res<3, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB 9B */ instr_res<3, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB 9C */ instr_res<3, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB 9D */ instr_res<3, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB 9E */ instr_res<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB 9F */ instr_res<3, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB A0 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB A1 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB A2 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB A3 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB A4 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB A5 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB A6 */ instr_res<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB A7 */ instr_res<4, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB A8 */ instr_res<5, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB A9 */ instr_res<5, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB AA */ instr_res<5, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB AB */ instr_res<5, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB AC */ instr_res<5, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB AD */ instr_res<5, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB AE */ instr_res<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB AF */ instr_res<5, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB B0 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB B1 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB B2 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB B3 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB B4 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB B5 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB B6 */ instr_res<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB B7 */ instr_res<6, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB B8 */ instr_res<7, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB B9 */ instr_res<7, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB BA */ instr_res<7, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB BB */ instr_res<7, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB BC */ instr_res<7, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB BD */ instr_res<7, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB BE */ instr_res<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB BF */ instr_res<7, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB C0 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB C1 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB C2 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB C3 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB C4 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB C5 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB C6 */ instr_set<0, AddressingMode::IYPlusPrevious>,
+            /* FD CB C7 */ instr_set<0, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB C8 */ instr_set<1, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB C9 */ instr_set<1, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB CA */ instr_set<1, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB CB */ instr_set<1, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB CC */ instr_set<1, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB CD */ instr_set<1, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB CE */ instr_set<1, AddressingMode::IYPlusPrevious>,
+            /* FD CB CF */ instr_set<1, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB D0 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB D1 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB D2 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB D3 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB D4 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB D5 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB D6 */ instr_set<2, AddressingMode::IYPlusPrevious>,
+            /* FD CB D7 */ instr_set<2, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB D8 */ instr_set<3, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB D9 */ instr_set<3, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB DA */ instr_set<3, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB DB */ instr_set<3, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB DC */ instr_set<3, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB DD */ instr_set<3, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB DE */ instr_set<3, AddressingMode::IYPlusPrevious>,
+            /* FD CB DF */ instr_set<3, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB E0 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB E1 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB E2 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB E3 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB E4 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB E5 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB E6 */ instr_set<4, AddressingMode::IYPlusPrevious>,
+            /* FD CB E7 */ instr_set<4, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB E8 */ instr_set<5, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB E9 */ instr_set<5, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB EA */ instr_set<5, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB EB */ instr_set<5, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB EC */ instr_set<5, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB ED */ instr_set<5, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB EE */ instr_set<5, AddressingMode::IYPlusPrevious>,
+            /* FD CB EF */ instr_set<5, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB F0 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB F1 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB F2 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB F3 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB F4 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB F5 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB F6 */ instr_set<6, AddressingMode::IYPlusPrevious>,
+            /* FD CB F7 */ instr_set<6, AddressingMode::IYPlusPrevious, Register::A>,
+            /* FD CB F8 */ instr_set<7, AddressingMode::IYPlusPrevious, Register::B>,
+            /* FD CB F9 */ instr_set<7, AddressingMode::IYPlusPrevious, Register::C>,
+            /* FD CB FA */ instr_set<7, AddressingMode::IYPlusPrevious, Register::D>,
+            /* FD CB FB */ instr_set<7, AddressingMode::IYPlusPrevious, Register::E>,
+            /* FD CB FC */ instr_set<7, AddressingMode::IYPlusPrevious, Register::H>,
+            /* FD CB FD */ instr_set<7, AddressingMode::IYPlusPrevious, Register::L>,
+            /* FD CB FE */ instr_set<7, AddressingMode::IYPlusPrevious>,
+            /* FD CB FF */ instr_set<7, AddressingMode::IYPlusPrevious, Register::A>
+    };
+
+    template <typename Bus>
+    int instr_cb(Core<Bus>& cpu) {
+        return cb_instructions<Bus>[cpu.read_byte(cpu.pc++)](cpu);
+    }
+
+    template <typename Bus>
+    int instr_dd(Core<Bus>& cpu) {
+        return dd_instructions<Bus>[cpu.read_byte(cpu.pc++)](cpu);
+    }
+
+    template <typename Bus>
+    int instr_ddcb(Core<Bus>& cpu) {
+        cpu.prev_immediate = cpu.read_byte(cpu.pc++);
+        return ddcb_instructions<Bus>[cpu.read_byte(cpu.pc++)](cpu);
+    }
+
+    template <typename Bus>
+    int instr_ed(Core<Bus>& cpu) {
+        return ed_instructions<Bus>[cpu.read_byte(cpu.pc++)](cpu);
+    }
+
+    template <typename Bus>
+    int instr_fd(Core<Bus>& cpu) {
+        return fd_instructions<Bus>[cpu.read_byte(cpu.pc++)](cpu);
+    }
+
+    template <typename Bus>
+    int instr_fdcb(Core<Bus>& cpu) {
+        cpu.prev_immediate = cpu.read_byte(cpu.pc++);
+        return fdcb_instructions<Bus>[cpu.read_byte(cpu.pc++)](cpu);
+    }
 }
 
 #endif //SMS_INSTRUCTIONS_H
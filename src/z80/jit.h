@@ -0,0 +1,261 @@
+#ifndef SMS_Z80_JIT_H
+#define SMS_Z80_JIT_H
+
+#include <bit>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <sys/mman.h>
+#endif
+
+#include "util/types.h"
+#include "util/log.h"
+
+#include "code_cache.h"
+
+namespace Z80 {
+#if defined(__x86_64__)
+    constexpr bool JIT_SUPPORTED = true;
+#else
+    constexpr bool JIT_SUPPORTED = false;
+#endif
+
+    // Times a block is run before it's translated
+    constexpr u32 JIT_THRESHOLD = 16;
+
+    // Translates cached blocks to x86-64. Common instructions that don't touch memory are translated directly,
+    // including the 8 bit ALU ones, which record their operands in F the way FlagRegister's setters do. Everything else
+    // calls its handler, with the same bookkeeping between instructions as the interpreter so both stop on exactly the
+    // same instruction.
+    //
+    // Translated blocks take the CPU and the cycles executed so far, and return the cycles executed after they're done.
+    // They stop early at the cycle deadline, after an interrupt, or when asked to with Core::break_block().
+    template <typename Bus>
+    class Jit {
+    public:
+        static constexpr size_t CODE_BUFFER_SIZE = 16 * 1024 * 1024;
+        // Upper bound on the code for one block
+        static constexpr size_t MAX_BLOCK_CODE = MAX_BLOCK_INSTRUCTIONS * 192 + 64;
+
+        ~Jit() {
+#if defined(__x86_64__)
+            if (buffer) {
+                munmap(buffer, CODE_BUFFER_SIZE);
+            }
+#endif
+        }
+
+        // Returns false if the code buffer is full. Call reset() after flushing the code cache to start again.
+        bool compile(Core<Bus>& cpu, Block<Bus>& block);
+
+        void reset() {
+            used = 0;
+        }
+
+    private:
+        u8* buffer = nullptr;
+        size_t used = 0;
+
+#if defined(__x86_64__)
+        enum Reg : u8 {
+            RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+            R8 = 8, R9 = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15
+        };
+
+        // Register usage in translated code:
+        //   rbx: the CPU
+        //   r12d: pc at the start of the block
+        //   r13d: cycles executed
+        u8* code;
+
+        void emit8(u8 value) {
+            *code++ = value;
+        }
+
+        void emit16(u16 value) {
+            memcpy(code, &value, sizeof(value));
+            code += sizeof(value);
+        }
+
+        void emit32(u32 value) {
+            memcpy(code, &value, sizeof(value));
+            code += sizeof(value);
+        }
+
+        void emit64(u64 value) {
+            memcpy(code, &value, sizeof(value));
+            code += sizeof(value);
+        }
+
+        // ModRM for [rbx + offset]
+        void emit_cpu_operand(u8 reg, int offset) {
+            emit8(0x80 | ((reg & 7) << 3) | RBX);
+            emit32(offset);
+        }
+
+        void emit_push(Reg reg) {
+            if (reg >= R8) {
+                emit8(0x41);
+            }
+            emit8(0x50 | (reg & 7));
+        }
+
+        void emit_pop(Reg reg) {
+            if (reg >= R8) {
+                emit8(0x41);
+            }
+            emit8(0x58 | (reg & 7));
+        }
+
+        // movzx eax, byte [rbx + offset]
+        void emit_load8(Reg dst, int offset) {
+            emit8(0x0F);
+            emit8(0xB6);
+            emit_cpu_operand(dst, offset);
+        }
+
+        // movzx eax, word [rbx + offset]
+        void emit_load16(Reg dst, int offset) {
+            if (dst >= R8) {
+                emit8(0x44);
+            }
+            emit8(0x0F);
+            emit8(0xB7);
+            emit_cpu_operand(dst, offset);
+        }
+
+        // mov byte [rbx + offset], al
+        void emit_store8(int offset, Reg src) {
+            emit8(0x88);
+            emit_cpu_operand(src, offset);
+        }
+
+        // mov word [rbx + offset], ax
+        void emit_store16(int offset, Reg src) {
+            emit8(0x66);
+            emit8(0x89);
+            emit_cpu_operand(src, offset);
+        }
+
+        // mov byte [rbx + offset], imm8
+        void emit_store8_imm(int offset, u8 value) {
+            emit8(0xC6);
+            emit_cpu_operand(0, offset);
+            emit8(value);
+        }
+
+        // mov word [rbx + offset], imm16
+        void emit_store16_imm(int offset, u16 value) {
+            emit8(0x66);
+            emit8(0xC7);
+            emit_cpu_operand(0, offset);
+            emit16(value);
+        }
+
+        // mov qword [rbx + offset], rax
+        void emit_store64(int offset, Reg src) {
+            emit8(0x48);
+            emit8(0x89);
+            emit_cpu_operand(src, offset);
+        }
+
+        // add word [rbx + offset], imm8
+        void emit_add16_imm(int offset, s8 value) {
+            emit8(0x66);
+            emit8(0x83);
+            emit_cpu_operand(0, offset);
+            emit8(value);
+        }
+
+        // add qword [rbx + offset], imm8
+        void emit_add64_imm(int offset, s8 value) {
+            emit8(0x48);
+            emit8(0x83);
+            emit_cpu_operand(0, offset);
+            emit8(value);
+        }
+
+        // The register to register forms below only take rax-rdi
+
+        // add (0x01), or (0x09), and (0x21), sub (0x29) or xor (0x31) eax, ecx
+        void emit_alu(u8 opcode, Reg dst, Reg src) {
+            emit8(opcode);
+            emit8(0xC0 | (src << 3) | dst);
+        }
+
+        // add (0), and (4) eax, imm8, sign extended
+        void emit_alu_imm(u8 operation, Reg dst, s8 value) {
+            emit8(0x83);
+            emit8(0xC0 | (operation << 3) | dst);
+            emit8(value);
+        }
+
+        // shl (4) or shr (5) eax, imm8
+        void emit_shift_imm(u8 operation, Reg dst, u8 count) {
+            emit8(0xC1);
+            emit8(0xC0 | (operation << 3) | dst);
+            emit8(count);
+        }
+
+        // mov eax, imm32
+        void emit_mov_imm32(Reg dst, u32 value) {
+            emit8(0xB8 | dst);
+            emit32(value);
+        }
+
+        // mov reg, imm64
+        void emit_mov_imm64(Reg dst, u64 value) {
+            emit8(dst >= R8 ? 0x49 : 0x48);
+            emit8(0xB8 | (dst & 7));
+            emit64(value);
+        }
+
+        // lea eax, [r12 + offset]
+        void emit_block_address(Reg dst, int offset) {
+            emit8(0x41);
+            emit8(0x8D);
+            emit8(0x80 | ((dst & 7) << 3) | 4);
+            emit8(0x24);
+            emit32(offset);
+        }
+
+        // Calls function(cpu)
+        void emit_call(const void* function) {
+            emit8(0x48); // mov rdi, rbx
+            emit8(0x89);
+            emit8(0xDF);
+            emit_mov_imm64(RAX, reinterpret_cast<u64>(function));
+            emit8(0xFF); // call rax
+            emit8(0xD0);
+        }
+
+        // jcc rel32, returning where the target goes so it can be patched later
+        u8* emit_jump(u8 condition) {
+            emit8(0x0F);
+            emit8(condition);
+            emit32(0);
+            return code - 4;
+        }
+
+        void patch_jump(u8* jump, const u8* target) {
+            s32 offset = target - (jump + 4);
+            memcpy(jump, &offset, sizeof(offset));
+        }
+
+        void emit_carry(Core<Bus>& cpu, Reg dst);
+        bool emit_native(Core<Bus>& cpu, const DecodedInstruction<Bus>& instr, int& cycles);
+        // Returns true if the instruction was translated, rather than calling its handler
+        bool emit_instruction(Core<Bus>& cpu, const DecodedInstruction<Bus>& instr, bool last, bool after_native,
+                              std::vector<u8*>& exits, std::vector<u8*>& interrupts);
+
+        static void service_interrupt(Core<Bus>* cpu);
+
+        static int offset(Core<Bus>& cpu, const void* member) {
+            return static_cast<const u8*>(member) - reinterpret_cast<const u8*>(&cpu);
+        }
+#endif
+    };
+}
+
+#endif //SMS_Z80_JIT_H
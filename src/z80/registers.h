@@ -1,6 +1,8 @@
 #ifndef SMS_REGISTERS_H
 #define SMS_REGISTERS_H
 
+#include <bit>
+
 #include "z80.h"
 
 namespace Z80 {
@@ -10,35 +12,173 @@ namespace Z80 {
         All = 0xFFFF
     };
 
+    // Bits of F
+    constexpr u8 FLAG_C  = 1 << 0; // Carry
+    constexpr u8 FLAG_N  = 1 << 1; // Add / Subtract
+    constexpr u8 FLAG_PV = 1 << 2; // Parity / Overflow
+    constexpr u8 FLAG_B3 = 1 << 3; // Bit 3 copy
+    constexpr u8 FLAG_H  = 1 << 4; // Half Carry
+    constexpr u8 FLAG_B5 = 1 << 5; // Bit 5 copy
+    constexpr u8 FLAG_Z  = 1 << 6; // Zero
+    constexpr u8 FLAG_S  = 1 << 7; // Signed
+
+    struct FlagTables {
+        // S, Z, b5 and b3 for a result
+        u8 sz53[0x100];
+        // The same plus P/V set for even parity
+        u8 sz53p[0x100];
+        // Everything but C after an inc / dec, indexed by the result
+        u8 inc[0x100];
+        u8 dec[0x100];
+        // Indexed by bit 3 of the first operand, second operand and result, in bits 0-2. The overflow tables use bit 7
+        // the same way.
+        u8 half_carry_add[8];
+        u8 half_carry_sub[8];
+        u8 overflow_add[8];
+        u8 overflow_sub[8];
+    };
+
+    constexpr FlagTables make_flag_tables() {
+        FlagTables tables {};
+        for (int i = 0; i < 0x100; i++) {
+            u8 sz53 = (i & (FLAG_S | FLAG_B5 | FLAG_B3)) | (i == 0 ? FLAG_Z : 0);
+            tables.sz53[i] = sz53;
+            tables.sz53p[i] = sz53 | (std::popcount((unsigned)i) % 2 == 0 ? FLAG_PV : 0);
+            tables.inc[i] = sz53 | (i == 0x80 ? FLAG_PV : 0) | ((i & 0xF) == 0x0 ? FLAG_H : 0);
+            tables.dec[i] = sz53 | (i == 0x7F ? FLAG_PV : 0) | ((i & 0xF) == 0xF ? FLAG_H : 0) | FLAG_N;
+        }
+        for (int i = 0; i < 8; i++) {
+            bool a = i & 1;
+            bool b = i & 2;
+            bool r = i & 4;
+            // Carry (or borrow) out of the bit, worked out from the bits going in and the one that came out
+            tables.half_carry_add[i] = (a + b + (r != (a ^ b)) >= 2) ? FLAG_H : 0;
+            tables.half_carry_sub[i] = (a < b + (r != (a ^ b))) ? FLAG_H : 0;
+            tables.overflow_add[i] = (a == b && r != a) ? FLAG_PV : 0;
+            tables.overflow_sub[i] = (a != b && r != a) ? FLAG_PV : 0;
+        }
+        return tables;
+    }
+
+    inline constexpr FlagTables flag_tables = make_flag_tables();
+
+    // The operation that last set the flags, if they haven't been worked out yet
+    enum class FlagOp : u8 {
+        None, // The flags are in value
+        Add,  // add, adc
+        Sub,  // sub, sbc, neg
+        Cp,   // Like Sub, but b3 and b5 come from the operand
+        And,
+        Or,   // or, xor
+        Inc,
+        Dec
+    };
+
+    // F, packed the same way as on the Z80.
+    //
+    // The 8 bit ALU instructions only record their operands and result, and F is worked out from them when something
+    // reads it. Usually the next ALU instruction overwrites it first. zero(), carry() and sign() are cheap enough for
+    // conditions to use without working out the rest.
     struct FlagRegister {
     public:
-        bool s;   // Signed
-        bool z;   // Zero
-        bool b5;  // Bit 5 copy
-        bool h;   // Half Carry
-        bool b3;  // Bit 3 copy
-        bool p_v; // Parity / Overflow
-        bool n;   // Add / Subtract
-        bool c;   // Carry
+        u8 value = 0;
+
+        FlagOp op = FlagOp::None;
+        u8 op1 = 0;
+        u8 op2 = 0;
+        // Bit 8 is the carry (or borrow). inc and dec keep the carry from before them there.
+        u16 result = 0;
+
+        bool zero() const {
+            return op == FlagOp::None ? value & FLAG_Z : (result & 0xFF) == 0;
+        }
+
+        bool carry() const {
+            return op == FlagOp::None ? value & FLAG_C : (result >> 8) & 1;
+        }
+
+        bool sign() const {
+            return op == FlagOp::None ? value & FLAG_S : (result >> 7) & 1;
+        }
+
+        void set_add(u8 a, u8 b, bool carry_in) {
+            op = FlagOp::Add;
+            op1 = a;
+            op2 = b;
+            result = a + b + carry_in;
+        }
+
+        void set_sub(u8 a, u8 b, bool borrow) {
+            op = FlagOp::Sub;
+            op1 = a;
+            op2 = b;
+            result = a - b - borrow;
+        }
+
+        void set_cp(u8 a, u8 b) {
+            op = FlagOp::Cp;
+            op1 = a;
+            op2 = b;
+            result = a - b;
+        }
+
+        void set_and(u8 value) {
+            op = FlagOp::And;
+            result = value;
+        }
+
+        void set_or(u8 value) {
+            op = FlagOp::Or;
+            result = value;
+        }
+
+        void set_inc(u8 before) {
+            result = (u8)(before + 1) | (carry() << 8);
+            op = FlagOp::Inc;
+        }
+
+        void set_dec(u8 before) {
+            result = (u8)(before - 1) | (carry() << 8);
+            op = FlagOp::Dec;
+        }
+
         u8 assemble() const {
-            return (s << 7)
-                   | (z << 6)
-                   | (b5 << 5)
-                   | (h << 4)
-                   | (b3 << 3)
-                   | (p_v << 2)
-                   | (n << 1)
-                   | (c << 0);
-        }
-        void set(u8 value) {
-            s   = ((value >> 7) & 1) == 1;
-            z   = ((value >> 6) & 1) == 1;
-            b5  = ((value >> 5) & 1) == 1;
-            h   = ((value >> 4) & 1) == 1;
-            b3  = ((value >> 3) & 1) == 1;
-            p_v = ((value >> 2) & 1) == 1;
-            n   = ((value >> 1) & 1) == 1;
-            c   = ((value >> 0) & 1) == 1;
+            return op == FlagOp::None ? value : evaluate();
+        }
+
+        void set(u8 new_value) {
+            op = FlagOp::None;
+            value = new_value;
+        }
+
+    private:
+        u8 evaluate() const {
+            u8 r = result;
+            u8 c = (result >> 8) & 1;
+            // See FlagTables
+            u8 lookup = ((op1 & 0x88) >> 3) | ((op2 & 0x88) >> 2) | ((r & 0x88) >> 1);
+            switch (op) {
+                case FlagOp::Add:
+                    return flag_tables.sz53[r] | flag_tables.half_carry_add[lookup & 7]
+                           | flag_tables.overflow_add[lookup >> 4] | c;
+                case FlagOp::Sub:
+                    return flag_tables.sz53[r] | flag_tables.half_carry_sub[lookup & 7]
+                           | flag_tables.overflow_sub[lookup >> 4] | FLAG_N | c;
+                case FlagOp::Cp:
+                    return (flag_tables.sz53[r] & (FLAG_S | FLAG_Z)) | (op2 & (FLAG_B5 | FLAG_B3))
+                           | flag_tables.half_carry_sub[lookup & 7] | flag_tables.overflow_sub[lookup >> 4] | FLAG_N | c;
+                case FlagOp::And:
+                    return flag_tables.sz53p[r] | FLAG_H;
+                case FlagOp::Or:
+                    return flag_tables.sz53p[r];
+                case FlagOp::Inc:
+                    return flag_tables.inc[r] | c;
+                case FlagOp::Dec:
+                    return flag_tables.dec[r] | c;
+                case FlagOp::None:
+                    break;
+            }
+            return value;
         }
     };
     enum class Register {
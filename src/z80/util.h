@@ -3,26 +3,26 @@
 
 namespace Z80 {
 
-    template <typename T>
-    void stack_push(T value) {
+    template <typename T, typename Bus>
+    void stack_push(Core<Bus>& cpu, T value) {
         if constexpr(std::is_same_v<T, u16>) {
             u8 hi = (value >> 8) & 0xFF;
             u8 lo = value & 0xFF;
-            stack_push<u8>(hi);
-            stack_push<u8>(lo);
+            stack_push<u8>(cpu, hi);
+            stack_push<u8>(cpu, lo);
         } else if constexpr(std::is_same_v<T, u8>) {
-            z80.write_byte(--z80.sp, value);
+            cpu.write_byte(--cpu.sp, value);
         }
     }
 
-    template <typename T>
-    T stack_pop() {
+    template <typename T, typename Bus>
+    T stack_pop(Core<Bus>& cpu) {
         if constexpr(std::is_same_v<T, u16>) {
-            u16 lo = stack_pop<u8>();
-            u16 hi = stack_pop<u8>();
+            u16 lo = stack_pop<u8>(cpu);
+            u16 hi = stack_pop<u8>(cpu);
             return (hi << 8) | lo;
         } else if constexpr(std::is_same_v<T, u8>) {
-            return z80.read_byte(z80.sp++);
+            return cpu.read_byte(cpu.sp++);
         }
     }
 }
@@ -1,30 +1,72 @@
 #ifndef SMS_Z80_H
 #define SMS_Z80_H
 
+#include <climits>
 #include <cstdint>
+#include <type_traits>
 
 #include "util/bitfield.h"
 #include "util/types.h"
 
 #include "registers.h"
+#include "code_cache.h"
+#include "jit.h"
 
 namespace Z80 {
-    typedef u8 (*read_byte_handler)(u16 address);
-    typedef void (*write_byte_handler)(u16 address, u8 value);
-    typedef u8 (*port_in_handler)(u8 port);
-    typedef void (*port_out_handler)(u8 port, u8 value);
+    // Every handler is passed the context pointer given to set_bus_handlers() / set_port_handlers(), so several CPUs
+    // can share the same handler functions.
+    typedef u8 (*read_byte_handler)(void* context, u16 address);
+    typedef void (*write_byte_handler)(void* context, u16 address, u8 value);
+    typedef u8 (*port_in_handler)(void* context, u8 port);
+    typedef void (*port_out_handler)(void* context, u8 port, u8 value);
 
-    typedef struct z80 {
-        read_byte_handler read_byte;
-        write_byte_handler write_byte;
-        port_in_handler port_in;
-        port_out_handler port_out;
+    // Bus for users that connect memory and ports at runtime.
+    struct CallbackBus {
+        read_byte_handler read_handler;
+        write_byte_handler write_handler;
+        port_in_handler in_handler;
+        port_out_handler out_handler;
+        void* bus_context;
+        void* port_context;
 
+        u8 read_byte(u16 address) {
+            return read_handler(bus_context, address);
+        }
+
+        void write_byte(u16 address, u8 value) {
+            write_handler(bus_context, address, value);
+        }
+
+        u8 port_in(u8 port) {
+            return in_handler(port_context, port);
+        }
+
+        void port_out(u8 port, u8 value) {
+            out_handler(port_context, port, value);
+        }
+    };
+
+    enum class Mode {
+        // Fetches and decodes every instruction as it's executed
+        Interpreter,
+        // Decodes straight-line runs of code once and caches them. Needs a bus with a code_page() member.
+        //
+        // Only faster than the interpreter on code full of DD, FD and CB prefixed instructions, which the interpreter
+        // decodes in two or three steps (see test/data/index_bench.z80). Elsewhere the interpreter's inlined handlers
+        // win, and code that rewrites itself, like zexdoc, is decoded over and over.
+        Cached,
+        // Like Cached, but translates the blocks to native code. Only on x86-64.
+        Jit
+    };
+
+    struct CpuState {
         int interrupt_mode;
 
         bool interrupt_pending;
         bool interrupts_enabled;
         bool next_interrupts_enabled;
+        // Set by halt until the next interrupt
+        bool halted;
 
         u8 a;
         FlagRegister f;
@@ -47,19 +89,203 @@ namespace Z80 {
         s8 prev_immediate;
 
         long instructions;
-    } z80_t;
+    };
+
+    // The Z80 core. Bus is any type with read_byte(), write_byte(), port_in() and port_out() members. It's known at
+    // compile time so its fast paths can be inlined into the instruction handlers.
+    //
+    // To support the cached and JIT modes, the bus also needs a `u8* code_page(u16 address)` member returning the host
+    // memory behind the CODE_PAGE_SIZE page containing address, or nullptr if it isn't backed by plain memory.
+    //
+    // If it also has a `u8* write_page(u16 address)` member, doing the same for writes, ldir and lddr copy straight
+    // between pages of host memory, and cpir and cpdr search them directly.
+    //
+    // If it has a `bool repeatable_port_in(u8 port)` member, returning true for ports that give the same value with no
+    // further effect when they're read again before the next event passed to run(), loops that only read memory and
+    // those ports are skipped up to that event (see skip_idle_loop()). Reading memory mustn't have side effects.
+    //
+    // The member functions are defined in core.h. Include that in the one file that instantiates a Core.
+    template <typename Bus>
+    struct Core : CpuState {
+        static constexpr bool has_code_pages = requires(Bus& b) { b.code_page(u16 {}); };
+        static constexpr bool has_write_pages = has_code_pages && requires(Bus& b) { b.write_page(u16 {}); };
+        static constexpr bool has_idle_loops = requires(Bus& b) { b.repeatable_port_in(u8 {}); };
+
+        Bus bus;
+        Mode mode = Mode::Interpreter;
+
+        // Resets the CPU state. The bus is left alone.
+        void reset();
+
+        void set_bus_handlers(read_byte_handler read, write_byte_handler write, void* context = nullptr) requires std::is_same_v<Bus, CallbackBus> {
+            bus.read_handler = read;
+            bus.write_handler = write;
+            bus.bus_context = context;
+        }
+
+        void set_port_handlers(port_in_handler in, port_out_handler out, void* context = nullptr) requires std::is_same_v<Bus, CallbackBus> {
+            bus.in_handler = in;
+            bus.out_handler = out;
+            bus.port_context = context;
+        }
+
+        void set_pc(u16 address) {
+            pc = address;
+        }
+
+        // The interrupt line is level triggered: it stays raised until the device acknowledges it.
+        void raise_interrupt() {
+            interrupt_pending = true;
+        }
+
+        void clear_interrupt() {
+            interrupt_pending = false;
+        }
+
+        void set_mode(Mode new_mode);
+
+        int step();
+        // Executes instructions until at least `cycles` cycles have passed. Returns the number of cycles executed past
+        // that point, which is negative if end_run() stopped it early.
+        //
+        // `idle_cycles` is when the next event that could change what the CPU sees happens, if that's later. A CPU
+        // stuck in an idle loop runs on until then, as it would if run() was called again and again up to it.
+        int run(int cycles, int idle_cycles = 0);
+        // Makes run() return after the current instruction
+        void end_run() {
+            run_cycles = 0;
+            break_block();
+        }
+
+        // The bus must call this when it changes what's mapped where, so a cached block doesn't run on past the change
+        void memory_map_changed() {
+            break_block();
+            code_cache.unlink();
+        }
+
+        void flush_code_cache() {
+            code_cache.flush();
+        }
+
+        // Cycles left before run() stops. Repeating instructions (ldir, otir, halt, etc) use this to carry on without
+        // going back through the dispatch loop, so it's kept up to date whenever their handlers run.
+        int cycles_left() const {
+            // block_deadline is INT_MIN after break_block()
+            return block_deadline > executed_cycles ? block_deadline - executed_cycles : 0;
+        }
+
+        // Cycles run so far in the current run(), up to the start of the instruction being executed, or of the
+        // iteration for repeating instructions. The bus can use this to time port accesses.
+        int cycles_run() const {
+            return executed_cycles + iteration_cycles;
+        }
+
+        // How far into the current instruction the iteration a repeating instruction is on started. Only instructions
+        // that access ports need to keep this up to date.
+        int iteration_cycles = 0;
+
+        // Host memory the `length` bytes at address can be written to directly, or nullptr if they aren't backed by
+        // plain memory or contain cached code. They mustn't cross a page.
+        u8* direct_write(u16 address, int length);
+
+        // Called by jumps back to pc, which took `cycles`. Returns the cycles of the iterations of the loop that were
+        // skipped, if it's an idle loop.
+        int skip_idle_loop(int cycles);
+
+        u8 read_byte(u16 address) {
+            return bus.read_byte(address);
+        }
+
+        void write_byte(u16 address, u8 value) {
+            forget_idle_loop();
+            bus.write_byte(address, value);
+            if constexpr (has_code_pages) {
+                if (code_cache.invalidate(bus, address)) {
+                    break_block();
+                }
+            }
+        }
+
+        // Reads an operand at pc. In the cached mode these were read when the block was decoded, and pc already points
+        // past them.
+        u8 fetch_byte() {
+            if (operands) {
+                return *operands++;
+            }
+            return read_byte(pc++);
+        }
+
+        u8 port_in(u8 port) {
+            if constexpr (has_idle_loops) {
+                if (!bus.repeatable_port_in(port)) {
+                    forget_idle_loop();
+                }
+            }
+            return bus.port_in(port);
+        }
+
+        void port_out(u8 port, u8 value) {
+            forget_idle_loop();
+            bus.port_out(port, value);
+        }
+
+    private:
+        void service_interrupt();
+        void log_instruction(u16 address, u8 opcode);
+        int execute_instruction();
+#ifdef Z80_THREADED_DISPATCH
+        int run_threaded();
+#endif
+        void execute_block(const Block<Bus>& block);
+        int run_cached();
+        int run_jit();
+
+        // Stops the cached block being run after the current instruction
+        void break_block() {
+            block_break = true;
+            block_deadline = INT_MIN;
+        }
+
+        // Outside a block there's nothing to stop, so once the instruction that broke it is done, repeating
+        // instructions can carry on to the end of the run again
+        void end_block_break() {
+            block_break = false;
+            block_deadline = run_cycles;
+        }
 
-    extern z80_t z80;
+        // For anything an idle loop can't do
+        void forget_idle_loop() {
+            if constexpr (has_idle_loops) {
+                idle_loop.matches = -1;
+            }
+        }
 
-    void reset();
-    void set_bus_handlers(read_byte_handler read_handler, write_byte_handler write_handler);
-    void set_port_handlers(port_in_handler in_handler, port_out_handler out_handler);
+        int run_cycles = 0;
+        int executed_cycles = 0;
+        // Cycle count the current block (or repeating instruction) stops at. Kept separately from run_cycles so the
+        // block loop only has one thing to check.
+        int block_deadline = 0;
+        bool block_break = false;
+        // Where run() can skip an idle loop to
+        int idle_run_cycles = 0;
+        const u8* operands = nullptr;
+        CodeCache<Bus> code_cache;
+        Jit<Bus> jit;
 
-    void set_pc(u16 address);
+        // The state at the last jump back, and how many iterations in a row have ended in the same state without
+        // anything but reads in between. -1 if something else has happened since.
+        struct IdleLoop {
+            CpuState state;
+            int cycles;
+            int matches = -1;
+        } idle_loop;
 
-    void raise_interrupt();
+        friend class Jit<Bus>;
+    };
 
-    int step();
+    // A CPU whose bus is set up with function pointers at runtime.
+    using Cpu = Core<CallbackBus>;
+    extern template struct Core<CallbackBus>;
 }
 
 #endif //SMS_Z80_H
@@ -1,7 +1,8 @@
 #include <iostream>
 #include <cstring>
+#include <string>
 
-#include "z80/z80.h"
+#include "z80/core.h"
 #include "util/load_bin.h"
 #include "util/types.h"
 #include "util/log.h"
@@ -11,14 +12,31 @@ using std::endl;
 
 u8 memory[0x10000];
 bool should_quit = false;
+// Everything the test printed, to check how it went
+std::string output;
 
-u8 read_byte(u16 address) {
-    return memory[address];
-}
+struct CpmBus {
+    u8 read_byte(u16 address) {
+        return memory[address];
+    }
 
-void write_byte(u16 address, u8 value) {
-    memory[address] = value;
-}
+    void write_byte(u16 address, u8 value) {
+        memory[address] = value;
+    }
+
+    u8* code_page(u16 address) {
+        return &memory[address & ~Z80::CODE_PAGE_MASK];
+    }
+
+    u8* write_page(u16 address) {
+        return &memory[address & ~Z80::CODE_PAGE_MASK];
+    }
+
+    u8 port_in(u8 port);
+    void port_out(u8 port, u8 value);
+};
+
+Z80::Core<CpmBus> cpu;
 
 void load_rom(const char* path) {
     auto data = load_bin<u8>(path);
@@ -27,19 +45,22 @@ void load_rom(const char* path) {
     }
 }
 
-u8 port_in(u8 port) {
-    u8 syscall = Z80::z80.bc[Z80::WideRegister::Lo];
+// BDOS calls, which the code at 5 makes with in a, (0). c is the call, and de its argument.
+u8 bdos_call(const Z80::CpuState& state) {
+    u8 syscall = state.bc[Z80::WideRegister::Lo];
 
     switch (syscall) {
         case 9: { // Print all characters until '$' is found
-            u16 addr = Z80::z80.de.raw;
+            u16 addr = state.de.raw;
             for (char c = (char)memory[addr++]; c != '$'; c = (char)memory[addr++]) {
                 printf("%c", c);
+                output += c;
             }
             break;
         }
         case 2: {
-            printf("%c", Z80::z80.de[Z80::WideRegister::Lo]);
+            printf("%c", state.de[Z80::WideRegister::Lo]);
+            output += (char)state.de[Z80::WideRegister::Lo];
             break;
         }
         default:
@@ -49,16 +70,60 @@ u8 port_in(u8 port) {
     return 0xFF;
 }
 
-void port_out(u8 port, u8 value) {
+u8 CpmBus::port_in(u8 port) {
+    return bdos_call(cpu);
+}
+
+void CpmBus::port_out(u8 port, u8 value) {
     should_quit = true; // Success!
+    cpu.end_run();
+}
+
+// The same machine connected through Z80::Cpu's function pointers, the way a dynamic user would, with the memory and
+// the CPU passed as the contexts
+Z80::Cpu callback_cpu;
+
+u8 callback_read_byte(void* context, u16 address) {
+    return static_cast<u8*>(context)[address];
+}
+
+void callback_write_byte(void* context, u16 address, u8 value) {
+    static_cast<u8*>(context)[address] = value;
+}
+
+u8 callback_port_in(void* context, u8 port) {
+    return bdos_call(*static_cast<Z80::Cpu*>(context));
+}
+
+void callback_port_out(void* context, u8 port, u8 value) {
+    should_quit = true;
+    static_cast<Z80::Cpu*>(context)->end_run();
 }
 
 int main(int argc, char** argv) {
-    if (argc != 2) {
-        cout << "Usage: " << argv[0] << " <test>" << endl;
+    if (argc < 2 || argc > 3) {
+        cout << "Usage: " << argv[0] << " <test> [interpreter|cached|jit|step|callback]" << endl;
         exit(1);
     }
 
+    Z80::Mode mode = Z80::Mode::Interpreter;
+    // One instruction at a time through step(), like the debugger
+    bool step = false;
+    bool callback = false;
+    if (argc == 3) {
+        if (strcmp(argv[2], "cached") == 0) {
+            mode = Z80::Mode::Cached;
+        } else if (strcmp(argv[2], "jit") == 0) {
+            mode = Z80::Mode::Jit;
+        } else if (strcmp(argv[2], "step") == 0) {
+            step = true;
+        } else if (strcmp(argv[2], "callback") == 0) {
+            callback = true;
+        } else if (strcmp(argv[2], "interpreter") != 0) {
+            logfatal("Unknown mode: %s", argv[2]);
+        }
+    }
+
     memset(memory, 0x00, 65535);
 
     memory[0x00] = 0xD3;
@@ -68,13 +133,29 @@ int main(int argc, char** argv) {
     memory[0x07] = 0xC9;
 
     std::cout << "Loaded CPM test: " << argv[1] << std::endl;
-    Z80::reset();
-    Z80::set_bus_handlers(read_byte, write_byte);
-    Z80::set_port_handlers(port_in, port_out);
-    Z80::set_pc(0x100);
+    cpu.reset();
+    cpu.set_mode(mode);
+    cpu.set_pc(0x100);
+    callback_cpu.reset();
+    callback_cpu.set_bus_handlers(callback_read_byte, callback_write_byte, memory);
+    callback_cpu.set_port_handlers(callback_port_in, callback_port_out, &callback_cpu);
+    callback_cpu.set_pc(0x100);
     load_rom(argv[1]);
     while (!should_quit) {
-        Z80::step();
+        if (callback) {
+            callback_cpu.run(100000);
+        } else if (step) {
+            cpu.step();
+        } else {
+            cpu.run(100000);
+        }
+    }
+
+    // zexall and zexdoc print ERROR for each test that fails, and carry on. prelim stops at the first failure, so it
+    // only gets to "Preliminary tests complete" if everything passed.
+    if (output.find("ERROR") != std::string::npos || output.find("complete") == std::string::npos) {
+        cout << endl << "FAILED" << endl;
+        return 1;
     }
-    exit(0);
+    return 0;
 }
\ No newline at end of file
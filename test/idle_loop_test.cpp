@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+
+#include "z80/core.h"
+#include "util/types.h"
+#include "util/log.h"
+
+// Runs loops that wait for an interrupt, polling a status port or RAM, once with run() skipping them up to the next
+// event and once an instruction at a time with step(). Both have to end up in exactly the same state.
+
+constexpr int LINE_CYCLES = 228;
+constexpr int FRAME_CYCLES = LINE_CYCLES * 262;
+constexpr u64 END_CYCLES = FRAME_CYCLES * 10 + 1234;
+constexpr u8 STATUS_PORT = 0xBF;
+constexpr u8 MAPPER_PORT = 0xFE;
+
+struct Machine;
+
+struct TestBus {
+    Machine* machine;
+
+    u8 read_byte(u16 address);
+    void write_byte(u16 address, u8 value);
+    u8* code_page(u16 address);
+    u8* write_page(u16 address);
+    u8 port_in(u8 port);
+    bool repeatable_port_in(u8 port) {
+        return port == STATUS_PORT;
+    }
+    void port_out(u8 port, u8 value);
+};
+
+struct Machine {
+    u8 memory[0x10000] {};
+    Z80::Core<TestBus> cpu;
+    // Master cycles so far, and when the next of each event is due
+    u64 now = 0;
+    u64 next_line = LINE_CYCLES;
+    u64 next_frame = FRAME_CYCLES;
+    bool frame_flag = false;
+    int status_reads = 0;
+
+    explicit Machine(Z80::Mode mode) {
+        // di; im 1; ld sp, 0xDFF0; jp 0x0100
+        load(0x0000, {0xF3, 0xED, 0x56, 0x31, 0xF0, 0xDF, 0xC3, 0x00, 0x01});
+        // Acknowledges the interrupt by reading the status, and sets a flag in RAM for the main loop
+        load(0x0038, {
+                0xF5,                   // push af
+                0xDB, STATUS_PORT,      // in a, (0xBF)
+                0x3E, 0x01,             // ld a, 1
+                0x32, 0x00, 0xC0,       // ld (0xC000), a
+                0xF1,                   // pop af
+                0xFB,                   // ei
+                0xC9,                   // ret
+        });
+        // Waits for a frame three ways: polling the status with interrupts off, polling RAM for the interrupt
+        // handler's flag, and halting
+        load(0x0100, {
+                0xF3,                   // 0100 di
+                0xDB, STATUS_PORT,      // 0101 in a, (0xBF)
+                0xCB, 0x7F,             // 0103 bit 7, a
+                0x28, 0xFA,             // 0105 jr z, 0x0101
+                0xAF,                   // 0107 xor a
+                0xD3, MAPPER_PORT,      // 0108 out (0xFE), a
+                0x32, 0x00, 0xC0,       // 010A ld (0xC000), a
+                0xFB,                   // 010D ei
+                0x3A, 0x00, 0xC0,       // 010E ld a, (0xC000)
+                0xB7,                   // 0111 or a
+                0x28, 0xFA,             // 0112 jr z, 0x010E
+                0x21, 0x00, 0x00,       // 0114 ld hl, 0x0000
+                0x11, 0x00, 0xC1,       // 0117 ld de, 0xC100
+                0x01, 0x00, 0x01,       // 011A ld bc, 0x0100
+                0xED, 0xB0,             // 011D ldir
+                0x76,                   // 011F halt
+                0xC3, 0x00, 0x01,       // 0120 jp 0x0100
+        });
+        cpu.bus.machine = this;
+        cpu.reset();
+        cpu.set_mode(mode);
+        cpu.set_pc(0);
+    }
+
+    void load(u16 address, std::initializer_list<u8> code) {
+        std::copy(code.begin(), code.end(), &memory[address]);
+    }
+
+    void handle_events() {
+        while (next_line <= now) {
+            next_line += LINE_CYCLES;
+        }
+        if (next_frame <= now) {
+            next_frame += FRAME_CYCLES;
+            frame_flag = true;
+            cpu.raise_interrupt();
+        }
+    }
+
+    // Like the emulator's main loop: runs to the next event, but on to the next interrupt if the CPU is idle
+    void run() {
+        while (now < END_CYCLES) {
+            handle_events();
+            u64 next_event = std::min({next_line, next_frame, END_CYCLES});
+            int budget = (int)(next_event - now);
+            int idle = (int)(std::min(next_frame, END_CYCLES) - now);
+            now += budget + cpu.run(budget, idle);
+        }
+    }
+
+    void step() {
+        while (now < END_CYCLES) {
+            handle_events();
+            now += cpu.step();
+        }
+    }
+};
+
+u8 TestBus::read_byte(u16 address) {
+    return machine->memory[address];
+}
+
+void TestBus::write_byte(u16 address, u8 value) {
+    machine->memory[address] = value;
+}
+
+u8* TestBus::code_page(u16 address) {
+    return &machine->memory[address & ~Z80::CODE_PAGE_MASK];
+}
+
+u8* TestBus::write_page(u16 address) {
+    return address >= 0xC000 ? &machine->memory[address & ~Z80::CODE_PAGE_MASK] : nullptr;
+}
+
+u8 TestBus::port_in(u8 port) {
+    if (port != STATUS_PORT) {
+        logfatal("Read from unexpected port %02X", port);
+    }
+    machine->status_reads++;
+    u8 status = machine->frame_flag ? 0x80 : 0x00;
+    machine->frame_flag = false;
+    machine->cpu.clear_interrupt();
+    return status;
+}
+
+void TestBus::port_out(u8 port, u8 value) {
+    if (port != MAPPER_PORT) {
+        logfatal("Write to unexpected port %02X", port);
+    }
+    machine->cpu.memory_map_changed();
+}
+
+int main() {
+    auto expected = std::make_unique<Machine>(Z80::Mode::Interpreter);
+    expected->step();
+
+    const Z80::Mode modes[] {Z80::Mode::Interpreter, Z80::Mode::Cached, Z80::Mode::Jit};
+    const char* names[] {"interpreter", "cached", "jit"};
+    for (int i = 0; i < 3; i++) {
+        if (modes[i] == Z80::Mode::Jit && !Z80::JIT_SUPPORTED) {
+            continue;
+        }
+        auto machine = std::make_unique<Machine>(modes[i]);
+        machine->run();
+
+        const Z80::CpuState& a = machine->cpu;
+        const Z80::CpuState& b = expected->cpu;
+        bool same_memory = memcmp(machine->memory, expected->memory, sizeof(machine->memory)) == 0;
+        if (!Z80::same_idle_state(a, b) || a.r != b.r || a.instructions != b.instructions
+            || machine->now != expected->now || !same_memory) {
+            logdie("%s: ended at pc %04X, r %02X, %ld instructions, %llu cycles. Stepping ended at pc %04X, r %02X, "
+                   "%ld instructions, %llu cycles.", names[i], a.pc, a.r, a.instructions,
+                   (unsigned long long)machine->now, b.pc, b.r, b.instructions, (unsigned long long)expected->now);
+        }
+        // Otherwise the loops weren't skipped at all, and there's nothing being tested
+        if (machine->status_reads * 10 > expected->status_reads) {
+            logdie("%s: read the status %d times, against %d stepping", names[i], machine->status_reads,
+                   expected->status_reads);
+        }
+        printf("%s: OK, %d status reads instead of %d\n", names[i], machine->status_reads, expected->status_reads);
+    }
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+
+#include "z80/core.h"
+#include "util/types.h"
+#include "util/log.h"
+
+// Runs the 8 bit ALU instructions over every pair of operands under the JIT, stopping after a few cycles at a time, and
+// checks the state against the interpreter at every stop. zexdoc can't do this, as it rewrites the instruction it's
+// testing every time, so that never gets translated.
+
+struct Machine;
+
+struct TestBus {
+    Machine* machine;
+
+    u8 read_byte(u16 address);
+    void write_byte(u16 address, u8 value);
+    u8* code_page(u16 address);
+    u8 port_in(u8 port) {
+        logfatal("Read from port %02X", port);
+    }
+    void port_out(u8 port, u8 value) {
+        logfatal("Write to port %02X", port);
+    }
+};
+
+struct Machine {
+    u8 memory[0x10000] {};
+    Z80::Core<TestBus> cpu;
+
+    explicit Machine(Z80::Mode mode) {
+        load(0x0000, {
+                0xF3,                   // 0000 di
+                0x31, 0x00, 0xF0,       // 0001 ld sp, 0xF000
+                0x11, 0x00, 0x00,       // 0004 ld de, 0
+                // d and e are the operands
+                0x7A, 0x83,             // 0007 ld a, d / add a, e
+                0x7A, 0x8B,             // 0009 ld a, d / adc a, e
+                0x7A, 0x93,             // 000B ld a, d / sub e
+                0x7A, 0x9B,             // 000D ld a, d / sbc a, e
+                0x7A, 0xA3,             // 000F ld a, d / and e
+                0x7A, 0xAB,             // 0011 ld a, d / xor e
+                0x7A, 0xB3,             // 0013 ld a, d / or e
+                0x7A, 0xBB,             // 0015 ld a, d / cp e
+                0x42, 0x04,             // 0017 ld b, d / inc b
+                0x4A, 0x0D,             // 0019 ld c, d / dec c
+                // F from a register, so the carry comes from the flags as they were stored, not an operation
+                0xD5, 0xF1,             // 001B push de / pop af
+                0x8B,                   // 001D adc a, e
+                0xD5, 0xF1,             // 001E push de / pop af
+                0x9A,                   // 0020 sbc a, d
+                0xD5, 0xF1,             // 0021 push de / pop af
+                0x04,                   // 0023 inc b
+                0xD5, 0xF1,             // 0024 push de / pop af
+                0x0D,                   // 0026 dec c
+                0x7A, 0xC6, 0x5A,       // 0027 ld a, d / add a, 0x5A
+                0xCE, 0xA5,             // 002A adc a, 0xA5
+                0xD6, 0x3C,             // 002C sub 0x3C
+                0xDE, 0xC3,             // 002E sbc a, 0xC3
+                0xE6, 0xF0,             // 0030 and 0xF0
+                0xEE, 0x0F,             // 0032 xor 0x0F
+                0xF6, 0x11,             // 0034 or 0x11
+                0xFE, 0x80,             // 0036 cp 0x80
+                0x87, 0x8F, 0x97, 0x9F, // 0038 add a, a / adc a, a / sub a / sbc a, a
+                0xA7, 0xAF, 0xB7, 0xBF, // 003C and a / xor a / or a / cp a
+                0x1C,                   // 0040 inc e
+                0xC2, 0x07, 0x00,       // 0041 jp nz, 0x0007
+                0x14,                   // 0044 inc d
+                0xC2, 0x07, 0x00,       // 0045 jp nz, 0x0007
+                0x76,                   // 0048 halt
+        });
+        cpu.bus.machine = this;
+        cpu.reset();
+        cpu.set_mode(mode);
+        cpu.set_pc(0);
+    }
+
+    void load(u16 address, std::initializer_list<u8> code) {
+        std::copy(code.begin(), code.end(), &memory[address]);
+    }
+};
+
+u8 TestBus::read_byte(u16 address) {
+    return machine->memory[address];
+}
+
+void TestBus::write_byte(u16 address, u8 value) {
+    machine->memory[address] = value;
+}
+
+u8* TestBus::code_page(u16 address) {
+    return &machine->memory[address & ~Z80::CODE_PAGE_MASK];
+}
+
+int main() {
+    if (!Z80::JIT_SUPPORTED) {
+        printf("No JIT on this platform\n");
+        return 0;
+    }
+
+    auto jit = std::make_unique<Machine>(Z80::Mode::Jit);
+    auto expected = std::make_unique<Machine>(Z80::Mode::Interpreter);
+
+    // Stops land on every instruction in turn as the budgets vary
+    u32 seed = 1;
+    long stops = 0;
+    u64 jit_cycles = 0;
+    u64 expected_cycles = 0;
+    while (!jit->cpu.halted) {
+        seed = seed * 1103515245 + 12345;
+        int budget = 1 + (seed >> 16) % 40;
+        jit_cycles += budget + jit->cpu.run(budget);
+        stops++;
+        while (expected->cpu.instructions < jit->cpu.instructions) {
+            expected_cycles += expected->cpu.step();
+        }
+
+        const Z80::CpuState& a = jit->cpu;
+        const Z80::CpuState& b = expected->cpu;
+        if (!Z80::same_idle_state(a, b) || a.r != b.r || a.instructions != b.instructions
+            || jit_cycles != expected_cycles) {
+            logdie("After %ld instructions the JIT has pc %04X, AF %02X%02X, BC %04X, DE %04X, %llu cycles. The "
+                   "interpreter has pc %04X, AF %02X%02X, BC %04X, DE %04X, %llu cycles.", a.instructions, a.pc, a.a,
+                   a.f.assemble(), a.bc.raw, a.de.raw, (unsigned long long)jit_cycles, b.pc, b.a, b.f.assemble(),
+                   b.bc.raw, b.de.raw, (unsigned long long)expected_cycles);
+        }
+    }
+    printf("OK, %ld instructions, checked at %ld stops\n", jit->cpu.instructions, stops);
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "vdp/planar.h"
+#include "util/types.h"
+#include "util/log.h"
+
+// Checks every planar to chunky kernel the CPU can run against the scalar one, for every combination of two planes'
+// bytes in both the low and high planes. With "bench", also times them.
+
+constexpr int NUM_ROWS = 0x10000;
+
+struct Converted {
+    std::vector<u8> chunky = std::vector<u8>(NUM_ROWS * 8);
+    std::vector<u8> chunky_hflip = std::vector<u8>(NUM_ROWS * 8);
+
+    bool operator==(const Converted& other) const = default;
+};
+
+Converted convert(Vdp::PlanarToChunky kernel, const std::vector<u8>& planar, int rows_per_call) {
+    Converted converted;
+    for (int row = 0; row < NUM_ROWS; row += rows_per_call) {
+        kernel(&planar[row * 4], &converted.chunky[row * 8], &converted.chunky_hflip[row * 8], rows_per_call);
+    }
+    return converted;
+}
+
+int main(int argc, char** argv) {
+    bool bench = argc > 1 && strcmp(argv[1], "bench") == 0;
+
+    for (int shift : {0, 16}) {
+        std::vector<u8> planar(NUM_ROWS * 4);
+        for (u32 row = 0; row < NUM_ROWS; row++) {
+            u32 planes = row << shift;
+            memcpy(&planar[row * 4], &planes, sizeof(planes));
+        }
+        Converted expected = convert(Vdp::planar_to_chunky_scalar, planar, NUM_ROWS);
+
+        for (const Vdp::PlanarKernel& kernel : Vdp::planar_kernels()) {
+            // Odd sizes to go through the leftovers after the wider loops
+            for (int rows_per_call : {1, 2, 4, 8, 16, NUM_ROWS}) {
+                if (convert(kernel.convert, planar, rows_per_call) != expected) {
+                    logdie("%s kernel doesn't match the scalar one, %d rows at a time, planes << %d", kernel.name,
+                           rows_per_call, shift);
+                }
+            }
+            for (int rows = 1; rows < 8; rows++) {
+                u8 chunky[8 * 8];
+                u8 chunky_hflip[8 * 8];
+                kernel.convert(&planar[0x1234 * 4], chunky, chunky_hflip, rows);
+                if (memcmp(chunky, &expected.chunky[0x1234 * 8], rows * 8) != 0
+                    || memcmp(chunky_hflip, &expected.chunky_hflip[0x1234 * 8], rows * 8) != 0) {
+                    logdie("%s kernel doesn't match the scalar one for %d rows", kernel.name, rows);
+                }
+            }
+            if (shift == 0) {
+                printf("%s: OK\n", kernel.name);
+            }
+        }
+
+        if (bench && shift == 0) {
+            for (const Vdp::PlanarKernel& kernel : Vdp::planar_kernels()) {
+                for (int rows_per_call : {1, NUM_ROWS}) {
+                    constexpr int REPEATS = 200;
+                    Converted converted;
+                    auto start = std::chrono::steady_clock::now();
+                    for (int i = 0; i < REPEATS; i++) {
+                        for (int row = 0; row < NUM_ROWS; row += rows_per_call) {
+                            kernel.convert(&planar[row * 4], &converted.chunky[row * 8],
+                                           &converted.chunky_hflip[row * 8], rows_per_call);
+                        }
+                    }
+                    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                    printf("%-6s %5d rows per call: %.2f ns per row\n", kernel.name, rows_per_call,
+                           elapsed.count() / (REPEATS * (double)NUM_ROWS));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "psg/psg.h"
+#include "scheduler/scheduler.h"
+#include "util/blip_buffer.h"
+#include "util/types.h"
+#include "util/log.h"
+
+// Checks the PSG's tone frequencies, noise sequences and volumes from the samples it makes, and that the blip buffer
+// gets steps to the right level and keeps aliasing down. With "bench", also times the PSG.
+
+// A frame of the NTSC master clock
+constexpr u64 FRAME_CYCLES = 3420 * 262;
+constexpr double FRAME_RATE = (double)Scheduler::master_clock / FRAME_CYCLES;
+// What the PSG's counters are clocked from
+constexpr double PSG_CLOCK = (double)Scheduler::master_clock / Scheduler::cpu_divider;
+
+u64 now;
+
+void reset() {
+    Scheduler::reset();
+    Psg::reset();
+    now = 0;
+}
+
+void write(u8 value) {
+    Psg::write(now, value);
+}
+
+// Sets a tone channel's period, or the noise control register, and volume (0 loudest, 15 off)
+void set_tone(int channel, u16 period, u8 volume) {
+    write(0x80 | (channel << 5) | (period & 0xF));
+    write(period >> 4);
+    write(0x90 | (channel << 5) | volume);
+}
+
+void set_noise(u8 control, u8 volume) {
+    write(0xE0 | control);
+    write(0xF0 | volume);
+}
+
+std::vector<s16> run_frames(int frames) {
+    std::vector<s16> samples;
+    for (int i = 0; i < frames; i++) {
+        now += FRAME_CYCLES;
+        Psg::end_frame(now);
+        samples.insert(samples.end(), Psg::samples(), Psg::samples() + Psg::sample_count());
+    }
+    return samples;
+}
+
+// Undoes the blip buffer's high-pass filter, to get back the level the chip was putting out. Each sample loses
+// 1 / (1 << BASS_SHIFT) of itself, so adding that back up gives the level to within a unit.
+std::vector<double> levels(const std::vector<s16>& samples) {
+    std::vector<double> out(samples.size());
+    double lost = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        out[i] = samples[i] + lost;
+        lost += samples[i] / (double)(1 << Util::BlipBuffer::BASS_SHIFT);
+    }
+    return out;
+}
+
+// Where the level rises through `threshold`, to a fraction of a sample
+std::vector<double> rising_edges(const std::vector<double>& level, double threshold) {
+    std::vector<double> edges;
+    for (size_t i = 1; i < level.size(); i++) {
+        if (level[i - 1] < threshold && level[i] >= threshold) {
+            edges.push_back(i - 1 + (threshold - level[i - 1]) / (level[i] - level[i - 1]));
+        }
+    }
+    return edges;
+}
+
+// Amplitude of the component at `frequency`, Blackman windowed
+double amplitude_at(const std::vector<s16>& samples, double frequency) {
+    double re = 0;
+    double im = 0;
+    double window_sum = 0;
+    size_t n = samples.size();
+    for (size_t i = 0; i < n; i++) {
+        double window = 0.42 - 0.5 * std::cos(2 * M_PI * i / (n - 1)) + 0.08 * std::cos(4 * M_PI * i / (n - 1));
+        double phase = 2 * M_PI * frequency * i / Psg::sample_rate;
+        re += samples[i] * window * std::cos(phase);
+        im += samples[i] * window * std::sin(phase);
+        window_sum += window;
+    }
+    return 2 * std::hypot(re, im) / window_sum;
+}
+
+void check_tone_frequencies() {
+    for (u16 period : {1023, 254, 10}) {
+        reset();
+        set_tone(0, period, 0);
+        std::vector<double> level = levels(run_frames(120));
+        std::vector<double> edges = rising_edges(level, 4096);
+        double measured = (edges.size() - 2) * Psg::sample_rate / (edges.back() - edges[1]);
+        double expected = PSG_CLOCK / (32 * period);
+        if (std::abs(measured - expected) > expected * 0.0005) {
+            logdie("Period %d made %.3f Hz, not %.3f Hz", period, measured, expected);
+        }
+    }
+    printf("tone frequencies: OK\n");
+}
+
+// Output after each shift of the register, from 0x8000
+std::vector<bool> lfsr_sequence(bool white, int length) {
+    std::vector<bool> bits;
+    u16 lfsr = 0x8000;
+    for (int i = 0; i < length; i++) {
+        u16 feedback = white ? ((lfsr ^ (lfsr >> 3)) & 1) : (lfsr & 1);
+        lfsr = (lfsr >> 1) | (feedback << 15);
+        bits.push_back(lfsr & 1);
+    }
+    return bits;
+}
+
+// With rate 3, the noise shifts at half the rate tone 2's output flips, which is silent here so it's only heard
+// through the noise
+void check_noise(bool white, u16 tone2_period) {
+    reset();
+    set_tone(2, tone2_period, 15);
+    set_noise((white ? 4 : 0) | 3, 0);
+    std::vector<double> level = levels(run_frames(240));
+
+    // The output after each shift, read back from how long it stays each way. The first shift's time isn't known, so
+    // it starts from the first 1.
+    double shift_samples = 2 * tone2_period * 16 * Psg::sample_rate / PSG_CLOCK;
+    std::vector<bool> heard;
+    bool output = level[0] >= 4096;
+    double since = -1;
+    for (size_t i = 1; i < level.size(); i++) {
+        bool now_output = level[i] >= 4096;
+        if (now_output == output) {
+            continue;
+        }
+        if (since >= 0) {
+            double shifts = (i - since) / shift_samples;
+            if (std::abs(shifts - std::round(shifts)) > 0.1) {
+                logdie("%s noise held its output for %.2f shifts, so it isn't following tone 2's period",
+                       white ? "White" : "Periodic", shifts);
+            }
+            heard.insert(heard.end(), (size_t)std::lround(shifts), output);
+        }
+        output = now_output;
+        since = i;
+    }
+
+    std::vector<bool> expected = lfsr_sequence(white, 1 << 16);
+    expected.erase(expected.begin(), std::find(expected.begin(), expected.end(), true));
+    if (heard.size() < 200 || !std::equal(heard.begin(), heard.end(), expected.begin())) {
+        logdie("%s noise doesn't follow the shift register from 0x8000 (%zu shifts heard)",
+               white ? "White" : "Periodic", heard.size());
+    }
+    printf("%s noise: OK\n", white ? "white" : "periodic");
+}
+
+void check_volumes() {
+    double loudest = 0;
+    for (int volume = 0; volume < 16; volume++) {
+        reset();
+        set_tone(1, 1023, volume);
+        std::vector<double> level = levels(run_frames(30));
+        // Most of the time it's at one level or the other, so the quartiles are the levels
+        std::sort(level.begin(), level.end());
+        double swing = level[level.size() * 3 / 4] - level[level.size() / 4];
+        if (volume == 0) {
+            loudest = swing;
+        }
+        double expected = volume == 15 ? 0 : loudest * std::pow(10, -2.0 * volume / 20);
+        if (std::abs(swing - expected) > 2) {
+            logdie("Volume %d swings by %.1f, not %.1f", volume, swing, expected);
+        }
+    }
+    // All four channels at full volume have to fit
+    if (loudest * 4 > 32767) {
+        logdie("Full volume is %.0f, so four channels would clip", loudest);
+    }
+    printf("volumes: OK\n");
+}
+
+// Each of the kernel's phases has to add up to exactly one step, or a constant level would drift. The high-pass
+// filter still has to bring the output back to 0.
+void check_step_level() {
+    Util::BlipBuffer blip(Scheduler::master_clock, Psg::sample_rate);
+    constexpr int STEP = 400;
+    constexpr int PHASES = 64;
+    constexpr double CYCLES_PER_SAMPLE = (double)Scheduler::master_clock / Psg::sample_rate;
+    std::vector<s16> samples;
+    s16 out[Util::BlipBuffer::MAX_SAMPLES];
+    for (int frame = 0; frame < 60; frame++) {
+        if (frame == 0) {
+            // Spread over a sample's worth of clock cycles, to hit every phase
+            for (int i = 0; i < PHASES; i++) {
+                blip.add_delta(10000 + (u32)(i * CYCLES_PER_SAMPLE / PHASES), STEP);
+            }
+        }
+        int count = blip.end_frame(FRAME_CYCLES, out);
+        samples.insert(samples.end(), out, out + count);
+    }
+    std::vector<double> level = levels(samples);
+    // The level read back is a fraction of a unit under, at most
+    for (size_t i = 100; i < level.size(); i++) {
+        if (level[i] <= STEP * PHASES - 1 || level[i] > STEP * PHASES) {
+            logdie("A constant level of %d came out as %.2f", STEP * PHASES, level[i]);
+        }
+    }
+    if (std::abs(samples.back()) > 1) {
+        logdie("The high-pass filter left the output at %d, not 0", samples.back());
+    }
+    printf("step level: OK\n");
+}
+
+// A full volume tone's fundamental, against the alias of a tone above the Nyquist frequency, in dB
+double alias_level() {
+    reset();
+    set_tone(0, 254, 0);
+    double tone = amplitude_at(run_frames(60), PSG_CLOCK / (32 * 254));
+
+    // Period 3 is 37.3 kHz, which would alias down to 10.7 kHz
+    reset();
+    set_tone(0, 3, 0);
+    double alias = amplitude_at(run_frames(60), Psg::sample_rate - PSG_CLOCK / (32 * 3));
+    return 20 * std::log10(alias / tone);
+}
+
+// Share of a core it takes to make the samples for `frames` frames in real time
+double cost(u16 period, int frames) {
+    reset();
+    set_tone(0, period, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        now += FRAME_CYCLES;
+        Psg::end_frame(now);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (frames / FRAME_RATE);
+}
+
+int main(int argc, char** argv) {
+    bool bench = argc > 1 && strcmp(argv[1], "bench") == 0;
+
+    check_tone_frequencies();
+    check_noise(true, 1023);
+    check_noise(false, 700);
+    check_volumes();
+    check_step_level();
+
+    double alias = alias_level();
+    if (alias > -70) {
+        logdie("A 37 kHz tone's alias is only %.1f dB down", alias);
+    }
+    printf("aliasing: OK, %.1f dB\n", alias);
+
+    if (bench) {
+        constexpr int FRAMES = 600;
+        printf("440 Hz tone: %.3f%% of a core\n", 100 * cost(254, FRAMES));
+        printf("period 1 tone: %.3f%% of a core\n", 100 * cost(1, FRAMES));
+    }
+}